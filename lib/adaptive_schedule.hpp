@@ -0,0 +1,69 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file adaptive_schedule.hpp
+ * @brief Round scheduling slowing down devices whose propositions and monitors are stable.
+ *
+ * A device passes the state it observed in the round (its propositions and monitor outputs, packed
+ * in an integer). Once the state has been unchanged for `k` rounds, the frequency of rounds given
+ * by the round schedule is halved, and halved again every further `k` stable rounds, up to a given
+ * maximum slowdown (not necessarily a power of two). Any change in the state restores the base
+ * frequency at once. A change happening while a device is slowed down is thus observed within the
+ * slowed period, so that the detection delay added is bounded by the maximum slowdown times the base
+ * period (in `smart_grid`, the lag behind the epoch boundaries where faults happen is logged as `epoch_lag`). The slowdown
+ * in use is stored in `round_slowdown`, so that it can be aggregated together with the monitors.
+ */
+
+#ifndef FCPP_ADAPTIVE_SCHEDULE_H_
+#define FCPP_ADAPTIVE_SCHEDULE_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include "lib/beautify.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+namespace tags {
+    //! @brief Factor by which the period of rounds of the current node is lengthened.
+    struct round_slowdown {};
+}
+
+//! @brief Default number of stable rounds before halving the frequency of rounds.
+constexpr size_t stable_rounds = 5;
+
+//! @brief The types used in export by adaptive scheduling.
+FUN_EXPORT adaptive_rounds_t = common::export_list<tuple<uint64_t, size_t>>;
+
+/**
+ * @brief Adapts the frequency of rounds to the stability of a state, returning the slowdown applied.
+ *
+ * @param state The propositions and monitor outputs observed in the round.
+ * @param max_slowdown The maximum factor by which the period of rounds can be lengthened (1 to disable).
+ * @param k The number of stable rounds after which the frequency is halved.
+ */
+FUN real_t adaptive_rounds(ARGS, uint64_t state, real_t max_slowdown, size_t k = stable_rounds) { CODE
+    // the state of the previous round, and for how many rounds it has been the same
+    size_t stable = get<1>(old(CALL, tuple<uint64_t, size_t>{state, 0}, [&](tuple<uint64_t, size_t> o){
+        return tuple<uint64_t, size_t>{state, get<0>(o) == state ? get<1>(o) + 1 : 0};
+    }));
+    real_t slowdown = 1;
+    for (size_t i = k; i <= stable and slowdown < max_slowdown; i += k) slowdown *= 2;
+    slowdown = std::max(std::min(slowdown, max_slowdown), real_t(1));
+    node.frequency(1 / slowdown);
+    node.storage(tags::round_slowdown{}) = slowdown;
+    return slowdown;
+}
+
+}
+
+}
+
+#endif // FCPP_ADAPTIVE_SCHEDULE_H_
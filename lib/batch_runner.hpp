@@ -0,0 +1,160 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file batch_runner.hpp
+ * @brief Headless execution of the case studies, with a throughput summary.
+ */
+
+#ifndef FCPP_BATCH_RUNNER_H_
+#define FCPP_BATCH_RUNNER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FCPP_BATCH_ISOLATED
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "lib/fcpp.hpp"
+#include "lib/profiler.hpp"
+#include "lib/columnar_output.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+namespace tags {
+    //! @brief Number of rounds performed by the current node.
+    struct round_count {};
+}
+
+//! @brief Number of rounds performed by all the nodes of the process so far, including terminated ones.
+inline std::atomic<size_t>& round_counter() {
+    static std::atomic<size_t> c{0};
+    return c;
+}
+
+//! @brief Counts the rounds performed by the current node (and by the process).
+FUN void count_round(ARGS) { CODE
+    ++node.storage(tags::round_count{});
+    round_counter().fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+
+//! @brief Namespace for running case studies without graphical interface.
+namespace batch_runner {
+
+//! @brief Number of threads given as first command line argument (defaults to the hardware concurrency).
+inline size_t threads(int argc, char** argv) {
+    if (argc > 1) return std::max(1, std::atoi(argv[1]));
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Total number of rounds performed by all the nodes of the process so far.
+ *
+ * Rounds of nodes which terminated are included, as well as those of other networks run by the
+ * process: the rounds of a run are the difference of the totals before and after it.
+ */
+inline size_t total_rounds() {
+    return coordination::round_counter().load();
+}
+
+//! @brief Peak resident memory of the process in MB (zero where not available).
+inline double peak_resident_mb() {
+#ifdef FCPP_BATCH_ISOLATED
+    rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Runs f in a child process and waits for it, so that its peak memory is measured on its own.
+ *
+ * The child starts as a copy of the calling process, so the growth of its peak resident memory
+ * is due to f alone, as long as the caller is small when f is called. Where processes cannot be forked,
+ * f is run in the calling process, where the peak also covers the previous runs.
+ */
+template <typename F>
+void isolated(F&& f) {
+#ifdef FCPP_BATCH_ISOLATED
+    std::cout.flush();
+    std::cerr.flush();
+    pid_t pid = ::fork();
+    if (pid < 0) throw std::runtime_error("cannot fork");
+    if (pid == 0) {
+        int code = 0;
+        try {
+            f();
+        } catch (std::exception const& e) {
+            std::cerr << e.what() << std::endl;
+            code = 1;
+        }
+        std::cout.flush();
+        std::cerr.flush();
+        std::_Exit(code);
+    }
+    int status = 0;
+    if (::waitpid(pid, &status, 0) < 0 or not WIFEXITED(status) or WEXITSTATUS(status) != 0)
+        throw std::runtime_error("isolated run failed");
+#else
+    f();
+#endif
+}
+
+/**
+ * @brief Runs a case study with the batch simulator, printing a throughput summary.
+ *
+ * The summary is meant to be printed within the comment block preceding the plot output. When
+ * profiling, it also lists the profiling scopes taking most time, and the whole profile is written
+ * in the folded format of flame graphs to a file named after the case study (e.g. `Crowd_Safety.folded`).
+ */
+template <typename opt, typename plotter_t>
+void run(std::string name, plotter_t& p, size_t threads) {
+    using namespace component::tags;
+    typename component::batch_simulator<opt>::net network{common::make_tagged_tuple<plotter, component::tags::threads>(&p, threads)};
+    size_t start_rounds = total_rounds();
+    auto start = std::chrono::steady_clock::now();
+    network.run();
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t rounds = total_rounds() - start_rounds;
+    std::cout << name << ": " << network.node_size() << " nodes, " << threads << " threads\n";
+    std::cout << "rounds: " << rounds << ", wall-clock: " << wall << " s, rounds/s: " << rounds / wall << "\n";
+#ifdef FCPP_PROFILE
+    std::string file = name;
+    std::replace(file.begin(), file.end(), ' ', '_');
+    std::ofstream folded(file + ".folded");
+    profiler::folded(folded);
+    profiler::summary(std::cout);
+    profiler::reset();
+#endif
+}
+
+}
+
+}
+
+#endif // FCPP_BATCH_RUNNER_H_
@@ -0,0 +1,201 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file columnar_output.hpp
+ * @brief Binary columnar output of the rows logged by aggregators, as an alternative to plotters.
+ *
+ * A columnar file starts with a header: the magic `FCOL`, a version, the number of columns and
+ * the number of rows per chunk (`uint32_t` each), followed by the name of every column (its length
+ * as `uint32_t` and its characters), padded with zeros to a multiple of 8 bytes. Chunks follow,
+ * each made of its number of rows (`uint64_t`) and of the values of every column in turn (`double`
+ * each). Every chunk has the number of rows given in the header, except possibly the last one.
+ */
+
+#ifndef FCPP_COLUMNAR_OUTPUT_H_
+#define FCPP_COLUMNAR_OUTPUT_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "lib/fcpp.hpp"
+#include "lib/mapped_file.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace for binary columnar output of aggregated time series.
+namespace columnar {
+
+//! @brief Magic string at the start of a columnar file.
+constexpr char magic[4] = {'F', 'C', 'O', 'L'};
+
+//! @brief Version of the columnar format.
+constexpr uint32_t version = 1;
+
+//! @brief Default number of rows per chunk.
+constexpr uint32_t default_chunk_rows = 4096;
+
+/**
+ * @brief Writer of a columnar file, to be used as plotter by the logger of a simulation.
+ *
+ * Rows are buffered until a chunk is complete and then appended to the file, so that memory
+ * stays constant along the run. The columns are given by the tags of the first row received.
+ */
+class writer {
+  public:
+    //! @brief Opens a columnar file for writing.
+    writer(std::string const& path, uint32_t chunk_rows = default_chunk_rows) : m_chunk_rows(chunk_rows) {
+        m_file = std::fopen(path.c_str(), "wb");
+        if (m_file == nullptr) throw std::runtime_error("cannot open columnar file " + path);
+    }
+
+    //! @brief Flushes the last chunk and closes the file.
+    ~writer() {
+        flush();
+        std::fclose(m_file);
+    }
+
+    writer(writer const&) = delete;
+    writer& operator=(writer const&) = delete;
+
+    //! @brief Appends a row.
+    template <typename... Ss, typename... Ts>
+    writer& operator<<(common::tagged_tuple<common::type_sequence<Ss...>, common::type_sequence<Ts...>> const& row) {
+        if (m_columns.empty()) {
+            header({common::strip_namespaces(common::type_name<Ss>())...});
+        }
+        size_t c = 0;
+        for (double x : {static_cast<double>(common::get<Ss>(row))...})
+            m_columns[c++].push_back(x);
+        if (++m_rows == m_chunk_rows) flush();
+        return *this;
+    }
+
+    //! @brief Appends the rows buffered to the file.
+    void flush() {
+        if (m_rows == 0) return;
+        write(uint64_t(m_rows));
+        for (auto& col : m_columns) {
+            std::fwrite(col.data(), sizeof(double), col.size(), m_file);
+            col.clear();
+        }
+        std::fflush(m_file);
+        m_rows = 0;
+    }
+
+  private:
+    //! @brief Writes the header of the file, given the column names.
+    void header(std::vector<std::string> const& names) {
+        std::fwrite(magic, 1, 4, m_file);
+        write(version);
+        write(uint32_t(names.size()));
+        write(m_chunk_rows);
+        size_t len = 16;
+        for (std::string const& n : names) {
+            write(uint32_t(n.size()));
+            std::fwrite(n.data(), 1, n.size(), m_file);
+            len += 4 + n.size();
+        }
+        for (; len % 8; ++len) std::fputc(0, m_file);
+        m_columns.resize(names.size());
+        for (auto& col : m_columns) col.reserve(m_chunk_rows);
+    }
+
+    //! @brief Writes a value to the file.
+    template <typename T>
+    void write(T x) {
+        std::fwrite(&x, sizeof(T), 1, m_file);
+    }
+
+    //! @brief The file being written.
+    FILE* m_file;
+
+    //! @brief Number of rows per chunk.
+    uint32_t m_chunk_rows;
+
+    //! @brief Number of rows buffered.
+    uint32_t m_rows = 0;
+
+    //! @brief Values buffered for every column.
+    std::vector<std::vector<double>> m_columns;
+};
+
+//! @brief Reader of a columnar file, mapped in memory whenever possible.
+class reader {
+  public:
+    //! @brief Opens a columnar file.
+    reader(std::string const& path) : m_file(path) {
+        if (m_file.size() == 0) return; // no row was logged
+        if (m_file.size() < 16 or std::memcmp(m_file.data(), magic, 4) != 0 or m_file.read<uint32_t>(4) != version)
+            throw std::runtime_error("invalid columnar file " + path);
+        uint32_t ncols = m_file.read<uint32_t>(8);
+        m_chunk_rows = m_file.read<uint32_t>(12);
+        size_t pos = 16;
+        for (uint32_t c = 0; c < ncols; ++c) {
+            uint32_t len = m_file.read<uint32_t>(pos);
+            m_names.emplace_back(m_file.data() + pos + 4, len);
+            pos += 4 + len;
+        }
+        for (pos = (pos + 7) / 8 * 8; pos + 8 <= m_file.size();) {
+            uint64_t rows = m_file.read<uint64_t>(pos);
+            pos += 8;
+            if (pos + rows * ncols * sizeof(double) > m_file.size()) break;
+            m_chunks.push_back(pos);
+            m_rows += rows;
+            pos += rows * ncols * sizeof(double);
+        }
+    }
+
+    //! @brief Names of the columns.
+    std::vector<std::string> const& columns() const {
+        return m_names;
+    }
+
+    //! @brief Index of the column with a given name (throws if missing).
+    size_t column(std::string const& name) const {
+        for (size_t c = 0; c < m_names.size(); ++c)
+            if (m_names[c] == name) return c;
+        throw std::out_of_range("no column " + name);
+    }
+
+    //! @brief Number of rows.
+    size_t rows() const {
+        return m_rows;
+    }
+
+    //! @brief The value in a given row and column.
+    double operator()(size_t row, size_t col) const {
+        size_t k = row / m_chunk_rows;
+        size_t rows = k + 1 < m_chunks.size() ? m_chunk_rows : m_rows - k * m_chunk_rows;
+        return m_file.read<double>(m_chunks[k] + (col * rows + row % m_chunk_rows) * sizeof(double));
+    }
+
+  private:
+    //! @brief The columnar file.
+    mapped_file m_file;
+
+    //! @brief Number of rows per chunk.
+    uint32_t m_chunk_rows = 0;
+
+    //! @brief Number of rows.
+    size_t m_rows = 0;
+
+    //! @brief Names of the columns.
+    std::vector<std::string> m_names;
+
+    //! @brief Positions of the chunks in the file.
+    std::vector<size_t> m_chunks;
+};
+
+}
+
+}
+
+#endif // FCPP_COLUMNAR_OUTPUT_H_
@@ -9,7 +9,14 @@
 #define FCPP_CROWD_SAFETY_H_
 
 #include "lib/fcpp.hpp"
+#include "lib/profiler.hpp"
+#include "lib/batch_runner.hpp"
+#include "lib/export_cost.hpp"
+#include "lib/failure_stats.hpp"
+#include "lib/proposition_trace.hpp"
+#include "lib/sweep.hpp"
 #include "lib/logic_samples.hpp"
+#include "lib/violation_provenance.hpp"
 
 
 /**
@@ -33,12 +40,17 @@ namespace tags {
     struct local_safety_monitor {};
     //! @brief Global value of the monitor formula.
     struct global_safety_monitor {};
+    //! @brief Distance estimation from the areas in panic.
+    struct distance_routine {};
     //! @brief Color representing the distance of the current node.
     struct col {};
     //! @brief Size of the current node.
     struct size {};
 }
 
+//! @brief Namespace of the crowd safety case study.
+inline namespace crowd_safety {
+
 
 //! @brief number of areas
 constexpr int nareas = 5;
@@ -52,6 +64,33 @@ constexpr double alert_radius = 100;
 //! @brief radius of the whole area
 constexpr double world_radius = 500;
 
+//! @brief Parameters of the case study which can be changed at runtime (defaulting to the constants above).
+struct parameters {
+    //! @brief number of areas
+    size_t nareas = coordination::nareas;
+    //! @brief radius of the incident effects
+    double inc_radius = coordination::inc_radius;
+    //! @brief radius of the alert effects
+    double alert_radius = coordination::alert_radius;
+    //! @brief radius of the whole area (the side of the square where people walk)
+    double world_radius = coordination::world_radius;
+
+    //! @brief Sets a parameter by name, returning whether it exists.
+    bool set(std::string const& name, double value) {
+        if (name == "nareas") nareas = value;
+        else if (name == "inc_radius") inc_radius = value;
+        else if (name == "alert_radius") alert_radius = value;
+        else if (name == "world_radius") world_radius = value;
+        else return false;
+        return true;
+    }
+};
+
+//! @brief The parameters used by the current thread.
+inline parameters& params() {
+    return sweep::current<parameters>();
+}
+
 //! @brief speed of the people
 constexpr double max_speed = 1.4;
 
@@ -66,7 +105,10 @@ MAIN() {
     using namespace tags;
     using namespace fcpp::component::tags;
 
-    bool isarea = (node.uid < nareas);
+    PROFILE_SCOPE("main");
+    count_round(CALL);
+
+    bool isarea = (node.uid < params().nareas);
     node.connector_data() = common::make_tagged_tuple<power_ratio,
 	    recv_power_ratio>(isarea ? 1 : 0.5, 1);
 
@@ -75,13 +117,16 @@ MAIN() {
     bool area_panic = isarea and node.current_time() > panic_time and node.current_time() < panic_time+panic_length;
 
     vec<2> low = make_vec(0,0);
-    vec<2> high = make_vec(500,500);
+    vec<2> high = make_vec(params().world_radius, params().world_radius);
 
-    double dist = bis_distance(CALL, area_panic, period, info_speed);
+    double dist = export_cost<distance_routine, payload<tuple<double,double>>>(CALL, [&](){
+        return bis_distance(CALL, area_panic, period, info_speed);
+    });
 
-    bool safe = (dist > inc_radius); // people are safe beyond this radius
-    bool alert = (dist < alert_radius); // people notice alerts within this radius
-    bool runaway = (dist < inc_radius*1.2); // people escape within this radius
+    bool safe = (dist > params().inc_radius); // people are safe beyond this radius
+    bool alert = (dist < params().alert_radius); // people notice alerts within this radius
+    bool runaway = (dist < params().inc_radius*1.2); // people escape within this radius
+    record_propositions(CALL, uint64_t(safe) | uint64_t(alert) << 1);
 
     if (!isarea) {
         if (alert && runaway) {
@@ -92,11 +137,19 @@ MAIN() {
             rectangle_walk(CALL, low, high, max_speed, period);
     }
 
-    bool my_safety_preserved = logic::my_safety_preserved(CALL, safe, alert);
-    bool all_safety_preserved = logic::all_safety_preserved(CALL, safe, alert);
+    bool my_safety_preserved = export_cost<local_safety_monitor, formula_payload<logic::fused::my_safety_preserved>>(CALL, [&](){
+        return logic::my_safety_preserved(CALL, safe, alert);
+    });
+    bool all_safety_preserved = export_cost<global_safety_monitor, formula_payload<logic::fused::all_safety_preserved>>(CALL, [&](){
+        return logic::all_safety_preserved(CALL, safe, alert);
+    });
 
     node.storage(fail<local_safety_monitor>{}) = not my_safety_preserved;
     node.storage(fail<global_safety_monitor>{}) = not all_safety_preserved;
+    track_failure<local_safety_monitor>(CALL, not my_safety_preserved);
+    track_failure<global_safety_monitor>(CALL, not all_safety_preserved);
+    record_provenance(CALL, uint64_t(safe) | uint64_t(alert) << 1, uint64_t(my_safety_preserved) | uint64_t(all_safety_preserved) << 1);
+    watch_violation(CALL, 0, "global_safety_monitor", not all_safety_preserved, not my_safety_preserved);
 
     if (isarea)
         node.storage(tags::size{}) = area_panic ? 15 : 10;
@@ -108,9 +161,9 @@ MAIN() {
     else {
         double hue;
         if (safe)
-            hue = 120 + (min(dist,world_radius)-inc_radius)*120/(world_radius-inc_radius);
+            hue = 120 + (min(dist,params().world_radius)-params().inc_radius)*120/(params().world_radius-params().inc_radius);
         else
-            hue = dist*60/inc_radius;
+            hue = dist*60/params().inc_radius;
         node.storage(col{}) = color::hsva(hue,1,1);
     }
 }
@@ -119,4 +172,127 @@ MAIN() {
 
 }
 
+//! @brief Namespace for all the simulation options.
+namespace option {
+
+//! @brief Simulation options of the crowd safety case study.
+inline namespace crowd_safety {
+
+using namespace component::tags;
+using namespace coordination::tags;
+
+//! @brief Number of atomic propositions recorded in traces (safe and alert).
+constexpr uint32_t trace_props = 2;
+
+//! @brief Number of people in the area.
+constexpr int node_num = 100;
+
+//! @brief Dimensionality of the space.
+constexpr size_t dim = 2;
+
+//! @brief Final time for the plots.
+constexpr size_t end_time = 400;
+
+
+//! @brief Description of the round schedule.
+using round_s = sequence::periodic<
+    distribution::interval_n<times_t, 0, 1>,
+    distribution::weibull_n<times_t, 10, 1, 10>,
+    distribution::constant_n<times_t, 2*end_time>
+>;
+
+//! @brief Description of the export schedule.
+using export_s = sequence::periodic_n<1, 0, 1, end_time>;
+
+//! @brief Description of the sequence of node creation events.
+using spawn_s = sequence::multiple_n<node_num, 0>;
+
+//! @brief Description of the initial position distribution.
+using rectangle_d = distribution::rect_n<1, 0, 0, 500, 500>;
+
+//! @brief Storage tags and types.
+using storage_t = tuple_store<
+    fail<local_safety_monitor>,     bool,
+    fail<global_safety_monitor>,    bool,
+    col,                            color,
+    size,                           double,
+    round_count,                    size_t
+>;
+
+//! @brief Storage tags to be logged with aggregators.
+using aggregator_t = aggregators<
+    fail<local_safety_monitor>,     aggregator::mean<double>,
+    fail<global_safety_monitor>,    aggregator::mean<double>
+>;
+
+//! @brief Calls whose export size is statically estimated.
+//! @{
+using cost_storage_t = coordination::export_cost_store<distance_routine, local_safety_monitor, global_safety_monitor>;
+using cost_aggregator_t = coordination::export_cost_aggregators<distance_routine, local_safety_monitor, global_safety_monitor>;
+//! @}
+
+//! @brief Monitors whose failure statistics are logged.
+//! @{
+using stats_storage_t = coordination::failure_stats_store<local_safety_monitor, global_safety_monitor>;
+using stats_aggregator_t = coordination::failure_stats_aggregators<local_safety_monitor, global_safety_monitor>;
+//! @}
+
+//! @brief Plot description.
+using plotter_t = coordination::failure_stats_plotter<coordination::export_cost_plotter<plot::plotter<aggregator_t, plot::time, fail>, cost_aggregator_t>, stats_aggregator_t>;
+
+//! @brief Number of rounds performed by every node in large venues.
+constexpr size_t large_end_time = 50;
+
+//! @brief Description of the round schedule in large venues (synchronous, to measure every round).
+using large_round_s = sequence::periodic_n<1, 0, 1, large_end_time-1>;
+
+//! @brief Options list for large venues (without plots, nodes to be created through `node_emplace`).
+template <bool parallel_flag>
+DECLARE_OPTIONS(large_list,
+    parallel<parallel_flag>,
+    synchronised<false>,
+    dimension<dim>,
+    program<coordination::main>,
+    exports<vec<dim>, double, bool, tuple<double,double>, coordination::provenance_t, coordination::export_cost_t>,
+    retain<metric::retain<2,1>>,
+    connector<connect::powered<200>>,
+    round_schedule<large_round_s>,
+    storage_t,
+    coordination::provenance_store,
+    cost_storage_t,
+    stats_storage_t
+);
+
+//! @brief Options list (with a given plotter type, the plot description by default).
+template <bool parallel_flag, typename plot_t = plotter_t>
+DECLARE_OPTIONS(list,
+    parallel<parallel_flag>,
+    synchronised<false>,
+    dimension<dim>,
+    program<coordination::main>,
+    exports<vec<dim>, double, bool, tuple<double,double>, coordination::provenance_t, coordination::export_cost_t>,
+    retain<metric::retain<2,1>>,
+    connector<connect::powered<200>>,
+    round_schedule<round_s>,
+    log_schedule<export_s>,
+    spawn_schedule<spawn_s>,
+    init<x, rectangle_d>,
+    storage_t,
+    coordination::provenance_store,
+    aggregator_t,
+    cost_storage_t,
+    cost_aggregator_t,
+    stats_storage_t,
+    stats_aggregator_t,
+    plot_type<plot_t>,
+    size_tag<size>,
+    color_tag<col>
+);
+
+}
+
+}
+
+}
+
 #endif // FCPP_CROWD_SAFETY_H_
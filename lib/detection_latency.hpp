@@ -0,0 +1,178 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file detection_latency.hpp
+ * @brief Accuracy and cost of distributed monitors, against a centralized reference checker.
+ *
+ * A `detection` replays a formula on a trace both as the distributed monitor and as the centralized
+ * reference checker. The distributed values are not those the nodes computed in the recorded run:
+ * they come from an offline re-evaluation of the fused monitor on the recorded propositions and
+ * neighbourhoods (`replay_monitor`). They match only as long as every node received the last
+ * round of each of its recorded neighbours.
+ *
+ * For every node, a violation episode lasts while the reference is false, and is detected in its first
+ * round of the node when the distributed monitor is false as well, with a latency in rounds and time
+ * from the start of the episode. Episodes ending (the reference turning true again) before being
+ * detected are missed (false negatives), and episodes undetected at the end of the trace are pending.
+ * Rounds where the distributed monitor is false outside of an episode are false alarms.
+ */
+
+#ifndef FCPP_DETECTION_LATENCY_H_
+#define FCPP_DETECTION_LATENCY_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "lib/failure_stats.hpp"
+#include "lib/streaming_monitor.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace for recording and replaying traces of atomic propositions.
+namespace proposition_trace {
+
+//! @brief Detection latency of a distributed monitor against its centralized reference.
+class detection {
+  public:
+    //! @brief Constructor, given the monitor as `formula[:bit,bit...]` and the propositions in the trace.
+    detection(std::string const& spec, size_t nprops) :
+        m_distributed(streaming::make_monitor<replay_monitor>(spec, nprops)),
+        m_reference(streaming::make_monitor<reference_monitor>(spec, nprops)) {}
+
+    //! @brief Evaluates both monitors in a recorded round.
+    void step(reader::record const& r) {
+        bool local = m_distributed->step(r);
+        bool truth = m_reference->step(r);
+        node_t& n = m_nodes[r.uid];
+        ++m_rounds;
+        // the neighbourhood includes the node itself, which sends no message to itself
+        for (size_t i = 0; i < r.nnbrs; ++i)
+            m_messages += r.nbr(i) != r.uid;
+        if (not truth) {
+            if (not n.violated) {
+                n.start_time = r.time;
+                n.start_round = n.rounds;
+                n.detected = false;
+                ++m_episodes;
+            }
+            if (not n.detected and not local) {
+                m_latency_rounds.insert(n.rounds - n.start_round);
+                m_latency_time.insert(r.time - n.start_time);
+                m_sum_rounds += n.rounds - n.start_round;
+                m_sum_time += r.time - n.start_time;
+                n.detected = true;
+                ++m_detected;
+            }
+        } else {
+            if (n.violated and not n.detected) ++m_missed;
+            if (not local) ++m_false_alarms;
+        }
+        n.violated = not truth;
+        ++n.rounds;
+    }
+
+    //! @brief Number of node-rounds evaluated.
+    size_t rounds() const {
+        return m_rounds;
+    }
+
+    //! @brief Number of violation episodes of the reference.
+    size_t episodes() const {
+        return m_episodes;
+    }
+
+    //! @brief Number of episodes detected by the distributed monitor.
+    size_t detected() const {
+        return m_detected;
+    }
+
+    //! @brief Number of episodes ended before being detected.
+    size_t missed() const {
+        return m_missed;
+    }
+
+    //! @brief Number of episodes still undetected at the end of the trace.
+    size_t pending() const {
+        return m_episodes - m_detected - m_missed;
+    }
+
+    //! @brief Number of rounds with the distributed monitor false and the reference true.
+    size_t false_alarms() const {
+        return m_false_alarms;
+    }
+
+    //! @brief Mean latency of detected episodes, in rounds of the node.
+    double mean_rounds() const {
+        return m_sum_rounds / double(m_detected);
+    }
+
+    //! @brief Mean latency of detected episodes, in time.
+    double mean_time() const {
+        return m_sum_time / m_detected;
+    }
+
+    //! @brief The q-quantile of the latency of detected episodes, in rounds of the node.
+    double quantile_rounds(double q) const {
+        return m_latency_rounds.quantile(q);
+    }
+
+    //! @brief The q-quantile of the latency of detected episodes, in time.
+    double quantile_time(double q) const {
+        return m_latency_time.quantile(q);
+    }
+
+    //! @brief Bytes sent by the distributed monitor in a round.
+    size_t state_bytes() const {
+        return m_distributed->state_bytes();
+    }
+
+    //! @brief Number of neighbour messages received by all the nodes.
+    size_t messages() const {
+        return m_messages;
+    }
+
+  private:
+    //! @brief The state of a node.
+    struct node_t {
+        //! @brief Number of rounds of the node.
+        uint32_t rounds = 0;
+        //! @brief Round when the last episode started.
+        uint32_t start_round = 0;
+        //! @brief Time when the last episode started.
+        double start_time = 0;
+        //! @brief Whether the reference was false in the last round (the last episode is ongoing).
+        bool violated = false;
+        //! @brief Whether the last episode was detected.
+        bool detected = false;
+    };
+
+    //! @brief The distributed monitor.
+    std::unique_ptr<replay_base> m_distributed;
+
+    //! @brief The centralized reference checker.
+    std::unique_ptr<replay_base> m_reference;
+
+    //! @brief The state of every node.
+    std::unordered_map<uint32_t, node_t> m_nodes;
+
+    //! @brief Counters of rounds, messages and episodes.
+    size_t m_rounds = 0, m_messages = 0, m_episodes = 0, m_detected = 0, m_missed = 0, m_false_alarms = 0;
+
+    //! @brief Sums of latencies of detected episodes.
+    double m_sum_rounds = 0, m_sum_time = 0;
+
+    //! @brief Latencies of detected episodes.
+    log_sketch m_latency_rounds, m_latency_time;
+};
+
+}
+
+}
+
+#endif // FCPP_DETECTION_LATENCY_H_
@@ -9,7 +9,12 @@
 #define FCPP_DRONES_RECOGNITION_H_
 
 #include "lib/fcpp.hpp"
+#include "lib/profiler.hpp"
+#include "lib/batch_runner.hpp"
+#include "lib/export_cost.hpp"
+#include "lib/proposition_trace.hpp"
 #include "lib/logic_samples.hpp"
+#include "lib/monitor_flags.hpp"
 
 
 /**
@@ -29,20 +34,37 @@ namespace tags {
     //! @brief Parametric tag for formula failure.
     template <typename T>
     struct fail {};
-    //! @brief Liveness monitor formula for area i.
-    template <int i>
+    //! @brief Liveness monitor formula (one flag per area).
     struct handling_monitor {};
-    //! @brief Safety monitor formula for area i.
-    template <int i>
+    //! @brief Safety monitor formula (one flag per area).
     struct redundancy_monitor {};
+    //! @brief Liveness and safety monitor formulas for all areas.
+    struct area_monitors {};
+    //! @brief Distance estimation from the needy towers.
+    struct distance_routine {};
+    //! @brief Broadcast of the position of the closest needy tower.
+    struct target_broadcast {};
+    //! @brief Collection of the distance of the closest free drone.
+    struct free_collection {};
+    //! @brief Broadcast of the distance of the closest free drone.
+    struct radius_broadcast {};
     //! @brief Color representing the kind of a node (person, light off, light on).
     struct col {};
     //! @brief Size of the current node (strong monitor true < globally false < locally false).
     struct size {};
 }
 
+//! @brief Namespace of the drones recognition case study.
+inline namespace drones_recognition {
+
+//! @brief Number of areas on each side of the square grid of areas (each with a tower in its centre).
+constexpr size_t area_grid = 2;
+
+//! @brief Number of areas.
+constexpr size_t areas_num = area_grid * area_grid;
+
 //! @brief Which area monitor to display with sizes.
-constexpr int area_display = 2;
+constexpr size_t area_display = 2;
 
 //! @brief Top speed for an UAV.
 constexpr real_t speed = 15;
@@ -62,6 +84,9 @@ constexpr real_t flying_high = 100;
 //! @brief Distance after which the target is taken for reached.
 constexpr real_t epsilon_dist = 1;
 
+//! @brief Positions as exported (to the millimetre).
+using position_t = quantized_vec<3, std::milli>;
+
 //! @brief Status of devices.
 enum class status {
     QUIET,  // tower before asking service
@@ -77,21 +102,9 @@ enum class status {
 //! @brief Colors to represent status.
 packed_color status_colors[8] = {MAROON, RED, MAROON, GRAY, BLUE, GREEN, YELLOW, GREEN};
 
-//! @brief Helper function to access storage.
-template <template<int> class T, typename node_t>
-bool& storage(node_t& node, size_t i) {
-    using namespace tags;
-    switch (i) {
-        case 1:
-            return node.storage(fail<T<1>>{});
-        case 2:
-            return node.storage(fail<T<2>>{});
-        case 3:
-            return node.storage(fail<T<3>>{});
-        default:
-            assert(i == 4);
-            return node.storage(fail<T<4>>{});
-    }
+//! @brief Centre of the i-th area, at a given height.
+inline vec<3> area_center(size_t i, real_t height) {
+    return make_vec((i % area_grid + 0.5) * 1000 / area_grid, (i / area_grid + 0.5) * 1000 / area_grid, height);
 }
 
 //! @brief Manages movement of drones towards targets.
@@ -133,9 +146,7 @@ FUN_EXPORT drone_automaton_t = common::export_list<coordination::follow_path_t>;
 
 //! @brief Manages neediness of towers.
 FUN void tower_automaton(ARGS, status& stat, bool close_handling) {
-    int x = node.uid % 2;
-    int y = node.uid / 2;
-    node.position() = make_vec(250+500*x,250+500*y,0);
+    node.position() = area_center(node.uid, 0);
     switch (stat) {
         case status::QUIET:
             if (node.current_time() > constant(CALL, node.next_real(0, 200)))
@@ -156,7 +167,10 @@ MAIN() {
     using namespace tags;
     using namespace component::tags;
 
-    bool tower = node.uid < 4;
+    PROFILE_SCOPE("main");
+    count_round(CALL);
+
+    bool tower = node.uid < areas_num;
     node.connector_data() = common::make_tagged_tuple<network_rank, power_ratio, recv_power_ratio>(tower ? 0 : 1, tower ? 1 : 0.5, 1);
 
     status stat = tower ? status::QUIET : status::TIRED;
@@ -170,17 +184,25 @@ MAIN() {
         if (tower) tower_automaton(CALL, stat, close_handling);
         else drone_automaton(CALL, stat, target);
 
-        real_t req_dist = bis_distance(CALL, stat == status::NEEDY, 1, 80);
-        vec<3> req_pos = broadcast(CALL, req_dist, node.position());
+        real_t req_dist = export_cost<distance_routine, payload<tuple<real_t, real_t>>>(CALL, [&](){
+            return bis_distance(CALL, stat == status::NEEDY, 1, 80);
+        });
+        vec<3> req_pos = export_cost<target_broadcast, payload<tuple<real_t, position_t>>>(CALL, [&](){
+            return broadcast(CALL, req_dist, wire_cost<target_broadcast>(CALL, node.position(), position_t(node.position())));
+        });
         req_pos[2] = flying_high;
         bool free = stat == status::WAIT or target == req_pos;
         real_t free_dist = free ? req_dist : INF;
-        real_t closest_free = mp_collection(CALL, req_dist, free_dist, INF, [&](real_t x, real_t y){
-            return min(x,y);
-        }, [&](real_t x, size_t) {
-            return x;
+        real_t closest_free = export_cost<free_collection, payload<real_t>>(CALL, [&](){
+            return mp_collection(CALL, req_dist, free_dist, INF, [&](real_t x, real_t y){
+                return min(x,y);
+            }, [&](real_t x, size_t) {
+                return x;
+            });
+        });
+        real_t req_radius = export_cost<radius_broadcast, payload<tuple<real_t, real_t>>>(CALL, [&](){
+            return broadcast(CALL, req_dist, closest_free);
         });
-        real_t req_radius = broadcast(CALL, req_dist, closest_free);
         if (stat == status::WAIT) {
             if (free_dist == req_radius and req_radius < INF) {
                 target = req_pos;
@@ -193,20 +215,143 @@ MAIN() {
         return make_tuple(stat, target);
     });
 
-    for (LOOP(i, 0); i<4; ++i) {
-        int x = i % 2;
-        int y = i / 2;
-        bool handling = stat == status::HANDLE and target == make_vec(250+500*x,250+500*y,flying_high);
-        bool area_handled = logic::area_handled(CALL, handling);
-        bool no_redundancy = logic::no_redundancy(CALL, handling);
-        storage<handling_monitor>(node, i+1) = not area_handled;
-        storage<redundancy_monitor>(node, i+1) = not no_redundancy;
-        if (i+1 == area_display)
-            node.storage(size{}) = 5 + (3 - no_redundancy - area_handled) * 5;
+    uint64_t trace_props = 0;
+    for (size_t i=0; i<areas_num and i<proposition_trace::max_props; ++i)
+        trace_props |= uint64_t(stat == status::HANDLE and target == area_center(i, flying_high)) << i;
+    record_propositions(CALL, trace_props);
+#ifdef FCPP_QUIESCENT_MONITORS
+    // quiescent monitors export less once settled, as they were in the previous round
+    size_t area_bytes = 0;
+    {
+        monitor_flags const& handling_fail = node.storage(fail<handling_monitor>{});
+        monitor_flags const& redundancy_fail = node.storage(fail<redundancy_monitor>{});
+        for (size_t i=0; i<areas_num; ++i) {
+            bool known = i < handling_fail.size() and i < redundancy_fail.size();
+            area_bytes += quiescent_payload<logic::fused::area_handled>::value_size(known and not handling_fail[i]);
+            area_bytes += quiescent_payload<logic::fused::no_redundancy>::value_size(not known or not redundancy_fail[i]);
+        }
     }
+#else
+    size_t area_bytes = areas_num * (formula_payload<logic::fused::area_handled>::size() + formula_payload<logic::fused::no_redundancy>::size());
+#endif
+    export_cost<area_monitors>(CALL, area_bytes, [&](){
+        monitor_flags& handling_fail = node.storage(fail<handling_monitor>{});
+        monitor_flags& redundancy_fail = node.storage(fail<redundancy_monitor>{});
+        handling_fail.resize(areas_num);
+        redundancy_fail.resize(areas_num);
+        for (LOOP(i, 0); i<int(areas_num); ++i) {
+            bool handling = stat == status::HANDLE and target == area_center(i, flying_high);
+#ifdef FCPP_QUIESCENT_MONITORS
+            bool area_handled = logic::quiescent::area_handled(CALL, handling);
+            bool no_redundancy = logic::quiescent::no_redundancy(CALL, handling);
+#else
+            bool area_handled = logic::area_handled(CALL, handling);
+            bool no_redundancy = logic::no_redundancy(CALL, handling);
+#endif
+            handling_fail.set(i, not area_handled);
+            redundancy_fail.set(i, not no_redundancy);
+            if (i+1 == int(area_display))
+                node.storage(size{}) = 5 + (3 - no_redundancy - area_handled) * 5;
+        }
+    });
     node.storage(col{}) = color(status_colors[(int)stat]);
 }
-FUN_EXPORT main_t = common::export_list<drone_automaton_t, tower_automaton_t, tuple<status, vec<3>>, coordination::logic_t, coordination::bis_distance_t, coordination::broadcast_t<real_t, vec<3>>, coordination::mp_collection_t<real_t, real_t>, coordination::broadcast_t<real_t, real_t>>;
+FUN_EXPORT main_t = common::export_list<drone_automaton_t, tower_automaton_t, tuple<status, vec<3>>, coordination::logic_t, coordination::quiescent_logic_t, coordination::bis_distance_t, coordination::broadcast_t<real_t, position_t>, coordination::mp_collection_t<real_t, real_t>, coordination::broadcast_t<real_t, real_t>, coordination::export_cost_t>;
+
+}
+
+}
+
+//! @brief Namespace for all the simulation options.
+namespace option {
+
+//! @brief Simulation options of the drones recognition case study.
+inline namespace drones_recognition {
+
+using namespace component::tags;
+using namespace coordination::tags;
+
+//! @brief Number of atomic propositions recorded in traces (handling of each area).
+constexpr uint32_t trace_props = std::min(areas_num, proposition_trace::max_props);
+
+//! @brief Number of drones in the area.
+constexpr size_t drones_num = 50;
+
+//! @brief Dimensionality of the space.
+constexpr size_t dim = 3;
+
+//! @brief Final time for the plots.
+constexpr size_t end_time = 300;
+
+
+//! @brief Description of the round schedule.
+using round_s = sequence::periodic<
+    distribution::interval_n<times_t, 0, 1>,
+    distribution::weibull_n<times_t, 10, 1, 10>,
+    distribution::constant_n<times_t, 2*end_time>
+>;
+
+//! @brief Description of the export schedule.
+using export_s = sequence::periodic_n<1, 0, 1, end_time>;
+
+//! @brief Description of the sequence of node creation events.
+using spawn_s = sequence::multiple_n<drones_num, 0>;
+
+//! @brief Description of the initial position distribution.
+using rectangle_d = distribution::rect_n<1, 0, 0, 0, 1000, 1000, 0>;
+
+//! @brief Storage tags and types.
+using storage_t = tuple_store<
+    fail<handling_monitor>,         monitor_flags,
+    fail<redundancy_monitor>,       monitor_flags,
+    col,                            color,
+    size,                           double,
+    round_count,                    size_t
+>;
+
+//! @brief Storage tags to be logged with aggregators.
+using aggregator_t = aggregators<
+    fail<handling_monitor>,         aggregator::flags,
+    fail<redundancy_monitor>,       aggregator::flags
+>;
+
+//! @brief Calls whose export size is statically estimated.
+//! @{
+using cost_storage_t = coordination::export_cost_store<area_monitors, distance_routine, target_broadcast, free_collection, radius_broadcast>;
+using cost_aggregator_t = coordination::export_cost_aggregators<area_monitors, distance_routine, target_broadcast, free_collection, radius_broadcast>;
+using wire_storage_t = coordination::wire_cost_store<target_broadcast>;
+using wire_aggregator_t = coordination::wire_cost_aggregators<target_broadcast>;
+//! @}
+
+//! @brief Plot description.
+using plotter_t = coordination::wire_cost_plotter<coordination::export_cost_plotter<plot::plotter<aggregator_t, plot::time, fail>, cost_aggregator_t>, wire_aggregator_t>;
+
+//! @brief Options list (with a given plotter type, the plot description by default).
+template <bool parallel_flag, typename plot_t = plotter_t>
+DECLARE_OPTIONS(list,
+    parallel<parallel_flag>,
+    synchronised<false>,
+    dimension<dim>,
+    program<coordination::main>,
+    exports<coordination::main_t>,
+    retain<metric::retain<2,1>>,
+    connector<connect::hierarchical<connect::powered<750, 1, dim>>>,
+    round_schedule<round_s>,
+    log_schedule<export_s>,
+    spawn_schedule<spawn_s>,
+    init<x, rectangle_d>,
+    storage_t,
+    aggregator_t,
+    cost_storage_t,
+    cost_aggregator_t,
+    wire_storage_t,
+    wire_aggregator_t,
+    plot_type<plot_t>,
+    size_tag<size>,
+    color_tag<col>
+);
+
+}
 
 }
 
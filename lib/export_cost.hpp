@@ -0,0 +1,348 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file export_cost.hpp
+ * @brief Static export estimates of monitors and application routines.
+ *
+ * When `FCPP_EXPORT_COST` is defined, every call wrapped by `export_cost<T, P>` stores in the node
+ * a static estimate of the bytes it adds to the export of the round (`est_export_bytes<T>`), given by
+ * the payload description `P` (or computed by the caller, as in `export_cost<T>(CALL, bytes, g)`).
+ * These are not measures of the exports actually serialised. The number of neighbours of the node
+ * (`nbr_degree`) is also stored. Since a node keeps the last export of every neighbour, their product
+ * bounds the bytes it holds for the exports of the call received from its neighbours
+ * (`est_nbr_bytes<T>`), assuming that every neighbour performed the call (which may not be the case
+ * if it is within a branch). `memory_report` prints it per node and call at the end of a run. The
+ * estimate reads the neighbourhood of the node without exporting anything itself, so it does not
+ * change the exports it estimates. Otherwise, wrapped calls are executed as they are.
+ *
+ * Every call wrapped by `export_cost<T>` is also a profiling scope named after T (see `lib/profiler.hpp`).
+ *
+ * Similarly, `wire_cost<T>` stores the bytes taken by a value in the plain encoding of exports
+ * (`wire_raw_bytes<T>`), and by its compact version in the delta encoding of `lib/wire_format.hpp`
+ * (`wire_bytes<T>`), so that their ratio gives the compression obtained.
+ */
+
+#ifndef FCPP_EXPORT_COST_H_
+#define FCPP_EXPORT_COST_H_
+
+#include <algorithm>
+#include <array>
+#include <ostream>
+#include <string>
+
+#include "lib/fcpp.hpp"
+#include "lib/fused_logic.hpp"
+#include "lib/profiler.hpp"
+#include "lib/wire_format.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+namespace tags {
+    //! @brief Estimated bytes exported in the current round by calls tagged by T (from their payload description).
+    template <typename T>
+    struct est_export_bytes {};
+    //! @brief Number of neighbours of the current node in the current round.
+    struct nbr_degree {};
+    //! @brief Estimated bytes held by the current node for the exports of calls tagged by T received from neighbours.
+    template <typename T>
+    struct est_nbr_bytes {};
+    //! @brief Bytes of the value of calls tagged by T in the current round, in the plain encoding.
+    template <typename T>
+    struct wire_raw_bytes {};
+    //! @brief Bytes of the value of calls tagged by T in the current round, in the compact encoding.
+    template <typename T>
+    struct wire_bytes {};
+    //! @brief Compact encoding of the value of calls tagged by T in the previous round.
+    template <typename T>
+    struct wire_last {};
+}
+
+//! @brief Serialised size of an export entry of type T (including its trace key).
+template <typename T>
+size_t entry_size() {
+    static size_t const s = [](){
+        common::osstream os;
+        os << trace_t{} << T{};
+        return os.size();
+    }();
+    return s;
+}
+
+//! @brief Payload given by one export entry for each of the types Ts.
+template <typename... Ts>
+struct payload {
+    static size_t size() {
+        size_t s = 0;
+        for (size_t e : {size_t(0), entry_size<Ts>()...}) s += e;
+        return s;
+    }
+};
+
+//! @brief Payload of formula F evaluated through nested operators on values of type T (one entry per temporal operator).
+template <typename F, typename T = bool>
+struct formula_payload {
+    static size_t size() {
+        return formula::state_size<F> * entry_size<T>();
+    }
+};
+
+//! @cond INTERNAL
+namespace details {
+    template <typename F, typename T, bool final_value>
+    struct quiescent_payload {
+        //! @brief The final value of the outermost operator.
+        static constexpr bool absorbing = final_value;
+
+        //! @brief Payload before settling (the phase, besides the nested operators).
+        static size_t size() {
+            return formula_payload<F, T>::size() + entry_size<int>();
+        }
+
+        //! @brief Payload once settled and quiet (the phase only).
+        static size_t settled_size() {
+            return entry_size<int>();
+        }
+
+        //! @brief Payload in a round following one where the outermost operator had a given value.
+        static size_t value_size(bool value) {
+            return value == absorbing ? settled_size() : size();
+        }
+    };
+}
+//! @endcond
+
+/**
+ * @brief Payload of formula F, whose outermost operator is AH or EP, evaluated through quiescent operators on values of type T.
+ *
+ * Before settling, quiescent operators export their phase besides the payload of the nested operators
+ * (`size`). Once settled their argument is no longer evaluated, and once quiet they only export their
+ * phase (`settled_size`), neglecting the boolean value sent once every period.
+ */
+template <typename F, typename T = bool>
+struct quiescent_payload;
+
+//! @brief Payload of formula `AH<F>` evaluated through `quiescent_AH` on values of type T.
+template <typename F, typename T>
+struct quiescent_payload<formula::AH<F>, T> : details::quiescent_payload<formula::AH<F>, T, false> {};
+
+//! @brief Payload of formula `EP<F>` evaluated through `quiescent_EP` on values of type T.
+template <typename F, typename T>
+struct quiescent_payload<formula::EP<F>, T> : details::quiescent_payload<formula::EP<F>, T, true> {};
+
+//! @brief Payload given by N repetitions of payload P.
+template <size_t N, typename P>
+struct repeat_payload {
+    static size_t size() {
+        return N * P::size();
+    }
+};
+
+//! @brief The types used in export by export cost accounting (none).
+FUN_EXPORT export_cost_t = common::export_list<>;
+
+#ifdef FCPP_EXPORT_COST
+//! @brief Executes g, accounting its estimated export cost as call T with a payload of given bytes.
+template <typename T, typename node_t, typename G>
+auto export_cost(ARGS, size_t bytes, G&& g) { CODE
+    PROFILE_SCOPE(profiler::name_of<T>());
+    size_t degree = 0;
+    for (device_t id : fcpp::details::get_ids(node.nbr_uid()))
+        degree += id != node.uid;
+    node.storage(tags::est_export_bytes<T>{}) = bytes;
+    node.storage(tags::nbr_degree{}) = degree;
+    node.storage(tags::est_nbr_bytes<T>{}) = bytes * degree;
+    return g();
+}
+#else
+//! @brief Executes g (export cost accounting disabled).
+template <typename T, typename node_t, typename G>
+auto export_cost(ARGS, size_t, G&& g) { CODE
+    PROFILE_SCOPE(profiler::name_of<T>());
+    return g();
+}
+#endif
+
+//! @brief Executes g, accounting its estimated export cost as call T with payload P.
+template <typename T, typename P, typename node_t, typename G>
+auto export_cost(ARGS, G&& g) { CODE
+#ifdef FCPP_EXPORT_COST
+    return export_cost<T>(CALL, P::size(), g);
+#else
+    PROFILE_SCOPE(profiler::name_of<T>());
+    return g();
+#endif
+}
+
+//! @brief Serialised bytes of a value.
+template <typename V>
+std::vector<char> wire_serialize(V const& v) {
+    common::osstream os;
+    os << v;
+    return os.data();
+}
+
+#ifdef FCPP_EXPORT_COST
+//! @brief Accounts the bytes of a value exported by call T in plain form, and of its compact form delta-encoded.
+template <typename T, typename node_t, typename R, typename C>
+C const& wire_cost(ARGS, R const& raw, C const& compact) { CODE
+    std::vector<char> cur = wire_serialize(compact);
+    std::vector<char>& last = node.storage(tags::wire_last<T>{});
+    node.storage(tags::wire_raw_bytes<T>{}) = wire_serialize(raw).size();
+    node.storage(tags::wire_bytes<T>{}) = wire::delta_encode(last, cur).size();
+    last = std::move(cur);
+    return compact;
+}
+#else
+//! @brief Returns the compact form of a value (export cost accounting disabled).
+template <typename T, typename node_t, typename R, typename C>
+C const& wire_cost(ARGS, R const&, C const& compact) { CODE
+    return compact;
+}
+#endif
+
+//! @cond INTERNAL
+namespace details {
+    template <typename S, typename... Ts>
+    struct export_cost_store;
+
+    template <typename... Ss>
+    struct export_cost_store<component::tags::tuple_store<Ss...>> {
+        using type = component::tags::tuple_store<Ss..., tags::nbr_degree, size_t>;
+    };
+
+    template <typename... Ss, typename T, typename... Ts>
+    struct export_cost_store<component::tags::tuple_store<Ss...>, T, Ts...> : export_cost_store<component::tags::tuple_store<Ss..., tags::est_export_bytes<T>, size_t, tags::est_nbr_bytes<T>, size_t>, Ts...> {};
+
+    template <typename S, typename... Ts>
+    struct export_cost_aggregators;
+
+    template <typename... Ss>
+    struct export_cost_aggregators<component::tags::aggregators<Ss...>> {
+        using type = component::tags::aggregators<Ss..., tags::nbr_degree, aggregator::mean<double>>;
+    };
+
+    template <typename... Ss, typename T, typename... Ts>
+    struct export_cost_aggregators<component::tags::aggregators<Ss...>, T, Ts...> : export_cost_aggregators<component::tags::aggregators<Ss..., tags::est_export_bytes<T>, aggregator::sum<size_t>, tags::est_nbr_bytes<T>, aggregator::combine<aggregator::mean<double>, aggregator::max<double>>>, Ts...> {};
+
+    template <typename S, typename... Ts>
+    struct wire_cost_store;
+
+    template <typename... Ss>
+    struct wire_cost_store<component::tags::tuple_store<Ss...>> {
+        using type = component::tags::tuple_store<Ss...>;
+    };
+
+    template <typename... Ss, typename T, typename... Ts>
+    struct wire_cost_store<component::tags::tuple_store<Ss...>, T, Ts...> : wire_cost_store<component::tags::tuple_store<Ss..., tags::wire_raw_bytes<T>, size_t, tags::wire_bytes<T>, size_t, tags::wire_last<T>, std::vector<char>>, Ts...> {};
+
+    template <typename S, typename... Ts>
+    struct wire_cost_aggregators;
+
+    template <typename... Ss>
+    struct wire_cost_aggregators<component::tags::aggregators<Ss...>> {
+        using type = component::tags::aggregators<Ss...>;
+    };
+
+    template <typename... Ss, typename T, typename... Ts>
+    struct wire_cost_aggregators<component::tags::aggregators<Ss...>, T, Ts...> : wire_cost_aggregators<component::tags::aggregators<Ss..., tags::wire_raw_bytes<T>, aggregator::sum<size_t>, tags::wire_bytes<T>, aggregator::sum<size_t>>, Ts...> {};
+}
+//! @endcond
+
+#ifdef FCPP_EXPORT_COST
+//! @brief Storage tags for the static export estimates of calls tagged by Ts.
+template <typename... Ts>
+using export_cost_store = typename details::export_cost_store<component::tags::tuple_store<>, Ts...>::type;
+
+//! @brief Aggregators for the static export estimates of calls tagged by Ts.
+template <typename... Ts>
+using export_cost_aggregators = typename details::export_cost_aggregators<component::tags::aggregators<>, Ts...>::type;
+
+//! @brief Plotter P extended with the static export estimates in aggregators A.
+template <typename P, typename A>
+using export_cost_plotter = plot::join<P, plot::plotter<A, plot::time, tags::est_export_bytes>, plot::plotter<A, plot::time, tags::est_nbr_bytes>>;
+
+/**
+ * @brief Prints as a JSON object the estimated mean bytes per node held for the neighbour exports of calls tagged by Ts.
+ *
+ * Prints the mean over the nodes of the network for every call (from the payload descriptions of
+ * the calls, as in `est_nbr_bytes`), with their total and the mean number of neighbours, as in the
+ * last round of every node.
+ */
+template <typename... Ts, typename net_t>
+void memory_report(net_t& network, std::ostream& out) {
+    std::array<double, sizeof...(Ts)> bytes{};
+    double degree = 0;
+    for (device_t uid = 0, n = 0; n < network.node_size(); ++uid)
+        if (network.node_count(uid)) {
+            auto& node = network.node_at(uid);
+            size_t i = 0;
+            for (size_t b : {node.storage(tags::est_nbr_bytes<Ts>{})...}) bytes[i++] += b;
+            degree += node.storage(tags::nbr_degree{});
+            ++n;
+        }
+    size_t nodes = std::max<size_t>(network.node_size(), 1);
+    double total = 0;
+    out << "{";
+    size_t i = 0;
+    for (std::string name : {common::strip_namespaces(common::type_name<Ts>())...}) {
+        out << "\"" << name << "\": " << bytes[i] / nodes << ", ";
+        total += bytes[i++] / nodes;
+    }
+    out << "\"total\": " << total << ", \"degree\": " << degree / nodes << "}";
+}
+
+//! @brief Storage tags for the wire costs of calls tagged by Ts.
+template <typename... Ts>
+using wire_cost_store = typename details::wire_cost_store<component::tags::tuple_store<>, Ts...>::type;
+
+//! @brief Aggregators for the wire costs of calls tagged by Ts.
+template <typename... Ts>
+using wire_cost_aggregators = typename details::wire_cost_aggregators<component::tags::aggregators<>, Ts...>::type;
+
+//! @brief Plotter P extended with the wire costs in aggregators A.
+template <typename P, typename A>
+using wire_cost_plotter = plot::join<P, plot::plotter<A, plot::time, tags::wire_raw_bytes>, plot::plotter<A, plot::time, tags::wire_bytes>>;
+#else
+//! @brief Storage tags for the static export estimates of calls tagged by Ts (none, estimates disabled).
+template <typename... Ts>
+using export_cost_store = component::tags::tuple_store<>;
+
+//! @brief Aggregators for the static export estimates of calls tagged by Ts (none, estimates disabled).
+template <typename... Ts>
+using export_cost_aggregators = component::tags::aggregators<>;
+
+//! @brief Plotter P extended with the static export estimates in aggregators A (P itself, estimates disabled).
+template <typename P, typename A>
+using export_cost_plotter = P;
+
+//! @brief Prints an empty JSON object (accounting disabled).
+template <typename... Ts, typename net_t>
+void memory_report(net_t&, std::ostream& out) {
+    out << "{}";
+}
+
+//! @brief Storage tags for the wire costs of calls tagged by Ts (none, accounting disabled).
+template <typename... Ts>
+using wire_cost_store = component::tags::tuple_store<>;
+
+//! @brief Aggregators for the wire costs of calls tagged by Ts (none, accounting disabled).
+template <typename... Ts>
+using wire_cost_aggregators = component::tags::aggregators<>;
+
+//! @brief Plotter P extended with the wire costs in aggregators A (P itself, accounting disabled).
+template <typename P, typename A>
+using wire_cost_plotter = P;
+#endif
+
+}
+
+}
+
+#endif // FCPP_EXPORT_COST_H_
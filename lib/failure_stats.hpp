@@ -0,0 +1,374 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file failure_stats.hpp
+ * @brief Statistics of monitor failures, with constant-memory aggregators mergeable across threads.
+ *
+ * Every node tracks for a monitor the time it first failed (`first_fail<T>`, infinite if it never did),
+ * the number of rounds it has been failing in a row (`fail_dwell<T>`, NaN if it is not failing) and the
+ * length of the failure episode ending in the current round (`fail_run<T>`, NaN in other rounds).
+ * The aggregators `first_true` (earliest time over the nodes), `sketch` (quantiles of a value over
+ * the nodes, skipping NaN) and `run_sketch` (quantiles of all the values ever logged, skipping NaN)
+ * use a fixed amount of memory regardless of the number of nodes, and can be merged, so that the
+ * logger can aggregate shards on different threads. Quantiles are estimated within a 2% relative
+ * error through logarithmic buckets. The sketch supports removal of values, so that it follows the
+ * ongoing dwell of the nodes currently failing. The run sketch keeps every completed episode, and the
+ * earliest failure is kept once recorded, even after the nodes which had them leave the network.
+ */
+
+#ifndef FCPP_FAILURE_STATS_H_
+#define FCPP_FAILURE_STATS_H_
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+/**
+ * @brief Histogram of non-negative values in logarithmic buckets, estimating quantiles within a relative error.
+ *
+ * Values are counted in the bucket `i` such that `gamma^(i-1) < x <= gamma^i`, with `gamma = 1.0408`
+ * giving a 2% relative error, for `i` within `[-buckets/2, buckets/2)` (about 1e-9 to 8e8). Smaller
+ * values (including zero and negative values) are counted apart, larger values in the last bucket.
+ */
+class log_sketch {
+  public:
+    //! @brief Number of buckets.
+    static constexpr size_t buckets = 1024;
+
+    //! @brief Relative error of quantile estimates.
+    static constexpr double error = 0.02;
+
+    //! @brief Counts a value (with a given multiplicity, negative to remove it).
+    void insert(double x, int64_t n = 1) {
+        m_count += n;
+        if (not (x > min_value())) m_low += n;
+        else m_data[index(x)] += n;
+    }
+
+    //! @brief Number of values counted.
+    int64_t count() const {
+        return m_count;
+    }
+
+    //! @brief Estimate of the q-quantile of the values counted (NaN if none).
+    double quantile(double q) const {
+        if (m_count <= 0) return std::numeric_limits<double>::quiet_NaN();
+        int64_t rank = std::llround(q * (m_count - 1));
+        int64_t seen = m_low;
+        if (rank < seen) return 0;
+        for (size_t i = 0; i < buckets; ++i) {
+            seen += m_data[i];
+            if (rank < seen) return 2 * std::pow(gamma(), double(i) - buckets / 2) / (gamma() + 1);
+        }
+        return std::pow(gamma(), double(buckets / 2 - 1));
+    }
+
+    //! @brief Merges the values counted in another sketch.
+    log_sketch& operator+=(log_sketch const& o) {
+        for (size_t i = 0; i < buckets; ++i) m_data[i] += o.m_data[i];
+        m_low += o.m_low;
+        m_count += o.m_count;
+        return *this;
+    }
+
+  private:
+    //! @brief Ratio between the bounds of buckets.
+    static constexpr double gamma() {
+        return (1 + error) / (1 - error);
+    }
+
+    //! @brief Upper bound of values counted apart.
+    static double min_value() {
+        return std::pow(gamma(), -double(buckets / 2) - 1);
+    }
+
+    //! @brief Bucket of a value.
+    static size_t index(double x) {
+        double i = std::ceil(std::log(x) / std::log(gamma())) + buckets / 2;
+        return i < 0 ? 0 : i >= buckets ? buckets - 1 : size_t(i);
+    }
+
+    //! @brief Counts of values in every bucket.
+    std::array<int64_t, buckets> m_data{};
+
+    //! @brief Count of values too small for buckets.
+    int64_t m_low = 0;
+
+    //! @brief Count of all values.
+    int64_t m_count = 0;
+};
+
+//! @brief Time of an event, infinite until the event happens.
+struct event_time {
+    //! @brief The time.
+    times_t value = TIME_MAX;
+
+    //! @brief Conversion to time.
+    operator times_t() const {
+        return value;
+    }
+};
+
+//! @brief Printing an event time.
+inline std::ostream& operator<<(std::ostream& o, event_time const& t) {
+    return o << t.value;
+}
+
+//! @brief Namespace for aggregators.
+namespace aggregator {
+
+//! @brief Tag for the earliest time.
+template <typename T>
+struct first_true_time {};
+
+/**
+ * @brief Earliest value ever aggregated before `TIME_MAX` (NaN if none), e.g. of times when nodes first failed.
+ *
+ * Removing values is not supported, as the next smallest value would need memory linear in the
+ * number of nodes: removed values are ignored, so that the earliest value stays recorded after
+ * the nodes having it leave the network. For values which are only set once (as `first_fail`),
+ * this is the earliest time any node of the run first failed.
+ */
+template <typename T>
+class first_true {
+  public:
+    //! @brief The type of values aggregated.
+    using type = T;
+
+    //! @brief The type of the aggregation result, given the tag of the aggregated values.
+    template <typename U>
+    using result_type = common::tagged_tuple_t<first_true_time<U>, double>;
+
+    //! @brief Default constructor.
+    first_true() = default;
+
+    //! @brief Combines aggregated values.
+    first_true& operator+=(first_true const& o) {
+        if (o.m_min < m_min) m_min = o.m_min;
+        return *this;
+    }
+
+    //! @brief Inserts a new value to be aggregated.
+    void insert(T value) {
+        if (not never(value) and value < m_min) m_min = value;
+    }
+
+    //! @brief Erases a value from the aggregation set (ignored, see above).
+    void erase(T) {}
+
+    //! @brief The results of aggregation.
+    template <typename U>
+    result_type<U> result() const {
+        return {never(m_min) ? std::numeric_limits<double>::quiet_NaN() : double(m_min)};
+    }
+
+    //! @brief The name of the aggregator.
+    static std::string name() {
+        return "first_true";
+    }
+
+  private:
+    //! @brief Whether a value stands for an event which did not happen.
+    static bool never(T value) {
+        return not (double(value) < double(TIME_MAX));
+    }
+
+    //! @brief The minimum value.
+    T m_min = TIME_MAX;
+};
+
+//! @brief Tag for the p-th percentile.
+template <typename T, size_t p>
+struct percentile {};
+
+//! @brief Type of the p-th percentile.
+template <size_t p>
+using percentile_value = double;
+
+//! @brief Quantiles of the values aggregated (skipping NaN), estimated in constant memory (see `log_sketch`).
+template <typename T, size_t... ps>
+class sketch {
+  public:
+    //! @brief The type of values aggregated.
+    using type = T;
+
+    //! @brief The type of the aggregation result, given the tag of the aggregated values.
+    template <typename U>
+    using result_type = common::tagged_tuple<common::type_sequence<percentile<U, ps>...>, common::type_sequence<percentile_value<ps>...>>;
+
+    //! @brief Default constructor.
+    sketch() = default;
+
+    //! @brief Combines aggregated values.
+    sketch& operator+=(sketch const& o) {
+        m_sketch += o.m_sketch;
+        return *this;
+    }
+
+    //! @brief Inserts a new value to be aggregated.
+    void insert(T value) {
+        if (not std::isnan(double(value))) m_sketch.insert(double(value));
+    }
+
+    //! @brief Erases a value from the aggregation set.
+    void erase(T value) {
+        if (not std::isnan(double(value))) m_sketch.insert(double(value), -1);
+    }
+
+    //! @brief The results of aggregation.
+    template <typename U>
+    result_type<U> result() const {
+        return {m_sketch.quantile(ps / 100.0)...};
+    }
+
+    //! @brief The name of the aggregator.
+    static std::string name() {
+        return "sketch";
+    }
+
+  private:
+    //! @brief The histogram of values.
+    log_sketch m_sketch;
+};
+
+/**
+ * @brief Quantiles of all the values ever aggregated (skipping NaN), estimated in constant memory (see `log_sketch`).
+ *
+ * Removed values are ignored, so that values logged by a node for a single round (as `fail_run`)
+ * are counted once and stay counted afterwards.
+ */
+template <typename T, size_t... ps>
+class run_sketch {
+  public:
+    //! @brief The type of values aggregated.
+    using type = T;
+
+    //! @brief The type of the aggregation result, given the tag of the aggregated values.
+    template <typename U>
+    using result_type = common::tagged_tuple<common::type_sequence<percentile<U, ps>...>, common::type_sequence<percentile_value<ps>...>>;
+
+    //! @brief Default constructor.
+    run_sketch() = default;
+
+    //! @brief Combines aggregated values.
+    run_sketch& operator+=(run_sketch const& o) {
+        m_sketch += o.m_sketch;
+        return *this;
+    }
+
+    //! @brief Inserts a new value to be aggregated.
+    void insert(T value) {
+        if (not std::isnan(double(value))) m_sketch.insert(double(value));
+    }
+
+    //! @brief Erases a value from the aggregation set (ignored, see above).
+    void erase(T) {}
+
+    //! @brief The results of aggregation.
+    template <typename U>
+    result_type<U> result() const {
+        return {m_sketch.quantile(ps / 100.0)...};
+    }
+
+    //! @brief The name of the aggregator.
+    static std::string name() {
+        return "run_sketch";
+    }
+
+  private:
+    //! @brief The histogram of values.
+    log_sketch m_sketch;
+};
+
+#ifdef FCPP_MULTI_RUNNER
+//! @brief Aggregators of the failure statistics (see `lib/monitor_instances.cpp`).
+//! @{
+extern template class first_true<times_t>;
+extern template class sketch<real_t, 50, 95, 99>;
+extern template class run_sketch<real_t, 50, 95, 99>;
+//! @}
+#endif
+
+}
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+namespace tags {
+    //! @brief Time when the monitor tagged by T first failed on the current node (infinite if never).
+    template <typename T>
+    struct first_fail {};
+    //! @brief Rounds the monitor tagged by T has been failing in a row on the current node (NaN if not failing).
+    template <typename T>
+    struct fail_dwell {};
+    //! @brief Rounds of the failure of the monitor tagged by T which ended in the current round on the current node (NaN if none).
+    template <typename T>
+    struct fail_run {};
+}
+
+//! @brief Tracks the failures of the monitor tagged by T, given whether it fails in the current round.
+template <typename T, typename node_t>
+void track_failure(ARGS, bool fail) { CODE
+    event_time& first = node.storage(tags::first_fail<T>{});
+    if (fail and first.value == TIME_MAX) first.value = node.current_time();
+    // only failing nodes contribute to the percentiles of dwell
+    real_t& dwell = node.storage(tags::fail_dwell<T>{});
+    // a completed episode is logged for a single round, and kept by its aggregator
+    node.storage(tags::fail_run<T>{}) = fail ? std::numeric_limits<real_t>::quiet_NaN() : dwell;
+    dwell = not fail ? std::numeric_limits<real_t>::quiet_NaN() : std::isnan(dwell) ? 1 : dwell + 1;
+}
+
+//! @cond INTERNAL
+namespace details {
+    template <typename S, typename... Ts>
+    struct failure_stats_store;
+
+    template <typename... Ss>
+    struct failure_stats_store<component::tags::tuple_store<Ss...>> {
+        using type = component::tags::tuple_store<Ss...>;
+    };
+
+    template <typename... Ss, typename T, typename... Ts>
+    struct failure_stats_store<component::tags::tuple_store<Ss...>, T, Ts...> : failure_stats_store<component::tags::tuple_store<Ss..., tags::first_fail<T>, event_time, tags::fail_dwell<T>, real_t, tags::fail_run<T>, real_t>, Ts...> {};
+
+    template <typename S, typename... Ts>
+    struct failure_stats_aggregators;
+
+    template <typename... Ss>
+    struct failure_stats_aggregators<component::tags::aggregators<Ss...>> {
+        using type = component::tags::aggregators<Ss...>;
+    };
+
+    template <typename... Ss, typename T, typename... Ts>
+    struct failure_stats_aggregators<component::tags::aggregators<Ss...>, T, Ts...> : failure_stats_aggregators<component::tags::aggregators<Ss..., tags::first_fail<T>, aggregator::first_true<times_t>, tags::fail_dwell<T>, aggregator::sketch<real_t, 50, 95, 99>, tags::fail_run<T>, aggregator::run_sketch<real_t, 50, 95, 99>>, Ts...> {};
+}
+//! @endcond
+
+//! @brief Storage tags for the failure statistics of monitors tagged by Ts.
+template <typename... Ts>
+using failure_stats_store = typename details::failure_stats_store<component::tags::tuple_store<>, Ts...>::type;
+
+//! @brief Aggregators for the failure statistics of monitors tagged by Ts (earliest failure, dwell percentiles of failing nodes, and percentiles of completed failure runs).
+template <typename... Ts>
+using failure_stats_aggregators = typename details::failure_stats_aggregators<component::tags::aggregators<>, Ts...>::type;
+
+//! @brief Plotter P extended with the failure statistics in aggregators A.
+template <typename P, typename A>
+using failure_stats_plotter = plot::join<P, plot::plotter<A, plot::time, tags::first_fail>, plot::plotter<A, plot::time, tags::fail_dwell>, plot::plotter<A, plot::time, tags::fail_run>>;
+
+}
+
+}
+
+#endif // FCPP_FAILURE_STATS_H_
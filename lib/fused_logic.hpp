@@ -0,0 +1,374 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file fused_logic.hpp
+ * @brief Compile-time Past-CTL formulas, evaluated as a single fused monitor.
+ *
+ * A formula is declared as a type built from the connectives in the `formula` namespace, e.g.
+ * `AH<impl<prop<1>, Y<S<neg<prop<1>>, prop<0>>>>>`. Every temporal operator of the formula is
+ * assigned a bit of a packed state at compile time, so that the whole formula is evaluated by
+ * a single `nbr` call whose export is the packed state, independently of the formula depth.
+ */
+
+#ifndef FCPP_FUSED_LOGIC_H_
+#define FCPP_FUSED_LOGIC_H_
+
+#include <array>
+#include <functional>
+
+#include "lib/beautify.hpp"
+#include "lib/coordination/past_ctl.hpp"
+#include "lib/packed_logic.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+//! @brief Namespace containing the type-level description of Past-CTL formulas.
+namespace formula {
+
+//! @brief The i-th atomic proposition given to the monitor.
+template <size_t i> struct prop {};
+//! @brief The true formula.
+struct top {};
+//! @brief The false formula.
+struct bot {};
+//! @brief Negation.
+template <typename F> struct neg {};
+//! @brief Conjunction.
+template <typename F, typename G> struct conj {};
+//! @brief Disjunction.
+template <typename F, typename G> struct disj {};
+//! @brief Implication.
+template <typename F, typename G> struct impl {};
+//! @brief Equivalence.
+template <typename F, typename G> struct iff {};
+//! @brief F held in the previous round (false initially).
+template <typename F> struct Y {};
+//! @brief F held since G held.
+template <typename F, typename G> struct S {};
+//! @brief F always held locally.
+template <typename F> struct H {};
+//! @brief F held in every causal predecessor event.
+template <typename F> struct AY {};
+//! @brief F held in every causal past event.
+template <typename F> struct AH {};
+//! @brief F held in some causal predecessor event.
+template <typename F> struct EY {};
+//! @brief F held in some causal past event.
+template <typename F> struct EP {};
+
+
+//! @cond INTERNAL
+namespace details {
+    //! @brief Evaluation context of a formula with P propositions and K state bits.
+    template <size_t P, size_t K>
+    struct context {
+        //! @brief The atomic propositions.
+        std::array<bool, P> const& props;
+        //! @brief The state of the current device in the previous round.
+        packed_bits<K> const& prev;
+        //! @brief Conjunction of the states of neighbours (current device included).
+        packed_bits<K> const& all;
+        //! @brief Disjunction of the states of neighbours (current device included).
+        packed_bits<K> const& any;
+        //! @brief The state being computed in the current round.
+        packed_bits<K>& next;
+    };
+
+    //! @brief Evaluator of a formula F, whose state bits start at offset O.
+    template <typename F, size_t O>
+    struct evaluator;
+
+    //! @brief Evaluator of atomic propositions.
+    template <size_t i, size_t O>
+    struct evaluator<prop<i>, O> {
+        static constexpr size_t size = 0;
+        template <typename T>
+        static void init(T&) {}
+        template <typename C>
+        static bool apply(C& c) {
+            return c.props[i];
+        }
+    };
+
+    //! @brief Evaluator of constant formulas.
+    template <bool b, size_t O>
+    struct constant_evaluator {
+        static constexpr size_t size = 0;
+        template <typename T>
+        static void init(T&) {}
+        template <typename C>
+        static bool apply(C&) {
+            return b;
+        }
+    };
+
+    template <size_t O>
+    struct evaluator<top, O> : constant_evaluator<true, O> {};
+
+    template <size_t O>
+    struct evaluator<bot, O> : constant_evaluator<false, O> {};
+
+    //! @brief Evaluator of negation.
+    template <typename F, size_t O>
+    struct evaluator<neg<F>, O> {
+        using f_t = evaluator<F, O>;
+        static constexpr size_t size = f_t::size;
+        template <typename T>
+        static void init(T& s) {
+            f_t::init(s);
+        }
+        template <typename C>
+        static bool apply(C& c) {
+            return not f_t::apply(c);
+        }
+    };
+
+    //! @brief Evaluator of binary boolean connectives.
+    template <typename F, typename G, size_t O, typename B>
+    struct binary_evaluator {
+        using f_t = evaluator<F, O>;
+        using g_t = evaluator<G, O + f_t::size>;
+        static constexpr size_t size = f_t::size + g_t::size;
+        template <typename T>
+        static void init(T& s) {
+            f_t::init(s);
+            g_t::init(s);
+        }
+        template <typename C>
+        static bool apply(C& c) {
+            // both sides are always evaluated, so that their state is updated
+            bool f = f_t::apply(c);
+            bool g = g_t::apply(c);
+            return B{}(f, g);
+        }
+    };
+
+    //! @brief Boolean implication.
+    struct implies {
+        bool operator()(bool f, bool g) const {
+            return f <= g;
+        }
+    };
+
+    template <typename F, typename G, size_t O>
+    struct evaluator<conj<F,G>, O> : binary_evaluator<F, G, O, std::logical_and<bool>> {};
+
+    template <typename F, typename G, size_t O>
+    struct evaluator<disj<F,G>, O> : binary_evaluator<F, G, O, std::logical_or<bool>> {};
+
+    template <typename F, typename G, size_t O>
+    struct evaluator<impl<F,G>, O> : binary_evaluator<F, G, O, implies> {};
+
+    template <typename F, typename G, size_t O>
+    struct evaluator<iff<F,G>, O> : binary_evaluator<F, G, O, std::equal_to<bool>> {};
+
+    /**
+     * @brief Evaluator of temporal operators with a single argument.
+     *
+     * @param F The argument formula.
+     * @param O The offset of the state bits.
+     * @param I The initial value of the state bit.
+     * @param U The update of the state bit, given the argument value and the context.
+     * @param R The operator value, given the context.
+     */
+    template <typename F, size_t O, bool I, typename U, typename R>
+    struct unary_evaluator {
+        using f_t = evaluator<F, O>;
+        static constexpr size_t index = O + f_t::size;
+        static constexpr size_t size = f_t::size + 1;
+        template <typename T>
+        static void init(T& s) {
+            f_t::init(s);
+            s.set(index, I);
+        }
+        template <typename C>
+        static bool apply(C& c) {
+            bool v = U{}(f_t::apply(c), c, index);
+            c.next.set(index, v);
+            return R{}(v, c, index);
+        }
+    };
+
+    //! @brief Stores the argument value.
+    struct store_arg {
+        template <typename C>
+        bool operator()(bool f, C&, size_t) const {
+            return f;
+        }
+    };
+
+    //! @brief The argument is conjuncted with the previous local value.
+    struct and_prev {
+        template <typename C>
+        bool operator()(bool f, C& c, size_t i) const {
+            return f and c.prev[i];
+        }
+    };
+
+    //! @brief The argument is conjuncted with the values of all neighbours.
+    struct and_all {
+        template <typename C>
+        bool operator()(bool f, C& c, size_t i) const {
+            return f and c.all[i];
+        }
+    };
+
+    //! @brief The argument is disjuncted with the values of any neighbour.
+    struct or_any {
+        template <typename C>
+        bool operator()(bool f, C& c, size_t i) const {
+            return f or c.any[i];
+        }
+    };
+
+    //! @brief The operator value is the updated state.
+    struct read_next {
+        template <typename C>
+        bool operator()(bool v, C&, size_t) const {
+            return v;
+        }
+    };
+
+    //! @brief The operator value is the previous local state.
+    struct read_prev {
+        template <typename C>
+        bool operator()(bool, C& c, size_t i) const {
+            return c.prev[i];
+        }
+    };
+
+    //! @brief The operator value is the conjunction of the neighbours' states.
+    struct read_all {
+        template <typename C>
+        bool operator()(bool, C& c, size_t i) const {
+            return c.all[i];
+        }
+    };
+
+    //! @brief The operator value is the disjunction of the neighbours' states.
+    struct read_any {
+        template <typename C>
+        bool operator()(bool, C& c, size_t i) const {
+            return c.any[i];
+        }
+    };
+
+    template <typename F, size_t O>
+    struct evaluator<Y<F>, O> : unary_evaluator<F, O, false, store_arg, read_prev> {};
+
+    template <typename F, size_t O>
+    struct evaluator<H<F>, O> : unary_evaluator<F, O, true, and_prev, read_next> {};
+
+    template <typename F, size_t O>
+    struct evaluator<AY<F>, O> : unary_evaluator<F, O, true, store_arg, read_all> {};
+
+    template <typename F, size_t O>
+    struct evaluator<AH<F>, O> : unary_evaluator<F, O, true, and_all, read_next> {};
+
+    template <typename F, size_t O>
+    struct evaluator<EY<F>, O> : unary_evaluator<F, O, false, store_arg, read_any> {};
+
+    template <typename F, size_t O>
+    struct evaluator<EP<F>, O> : unary_evaluator<F, O, false, or_any, read_next> {};
+
+    //! @brief Evaluator of the since operator.
+    template <typename F, typename G, size_t O>
+    struct evaluator<S<F,G>, O> {
+        using f_t = evaluator<F, O>;
+        using g_t = evaluator<G, O + f_t::size>;
+        static constexpr size_t index = O + f_t::size + g_t::size;
+        static constexpr size_t size = f_t::size + g_t::size + 1;
+        template <typename T>
+        static void init(T& s) {
+            f_t::init(s);
+            g_t::init(s);
+            s.set(index, false);
+        }
+        template <typename C>
+        static bool apply(C& c) {
+            bool f = f_t::apply(c);
+            bool g = g_t::apply(c);
+            bool v = g or (f and c.prev[index]);
+            c.next.set(index, v);
+            return v;
+        }
+    };
+}
+//! @endcond
+
+
+//! @brief Number of state bits needed by a formula.
+template <typename F>
+constexpr size_t state_size = details::evaluator<F, 0>::size;
+
+//! @brief Packed state of a formula (at least one bit, for formulas without temporal operators).
+template <typename F>
+using state_t = packed_bits<state_size<F> == 0 ? 1 : state_size<F>>;
+
+//! @brief Initial state of a formula.
+template <typename F>
+state_t<F> initial_state() {
+    state_t<F> s;
+    details::evaluator<F, 0>::init(s);
+    return s;
+}
+
+/**
+ * @brief Evaluates formula F in a round, updating its state.
+ *
+ * @param props The atomic propositions.
+ * @param prev The state of the current device in the previous round.
+ * @param all Conjunction of the states of neighbours (current device included).
+ * @param any Disjunction of the states of neighbours (current device included).
+ * @param next The state to be updated (initially equal to `prev`).
+ */
+template <typename F, size_t P>
+bool evaluate(std::array<bool, P> const& props, state_t<F> const& prev, state_t<F> const& all, state_t<F> const& any, state_t<F>& next) {
+    details::context<P, state_t<F>::size()> c{props, prev, all, any, next};
+    return details::evaluator<F, 0>::apply(c);
+}
+
+}
+
+
+//! @brief The types used in export by a fused monitor of formula F.
+template <typename F>
+FUN_EXPORT fused_monitor_t = common::export_list<formula::state_t<F>>;
+
+/**
+ * @brief Evaluates formula F on the given atomic propositions, as a single aggregate call.
+ *
+ * The propositions are referred by position in the formula (`prop<0>` is the first one).
+ */
+template <typename F, typename node_t, typename... Ps>
+bool fused_monitor(ARGS, Ps... ps) { CODE
+    using state_type = formula::state_t<F>;
+    std::array<bool, sizeof...(Ps)> props{{bool(ps)...}};
+    bool result;
+    nbr(CALL, formula::initial_state<F>(), [&](field<state_type> const& o){
+        state_type prev = self(CALL, o);
+        state_type all = fold_hood(CALL, [](state_type const& x, state_type const& y){
+            return x & y;
+        }, o);
+        state_type any = fold_hood(CALL, [](state_type const& x, state_type const& y){
+            return x | y;
+        }, o);
+        state_type next = prev;
+        result = formula::evaluate<F>(props, prev, all, any, next);
+        return next;
+    });
+    return result;
+}
+
+}
+
+}
+
+#endif // FCPP_FUSED_LOGIC_H_
@@ -0,0 +1,263 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file logic_benchmark.hpp
+ * @brief Evaluation of every logical formula on synthetic networks, for benchmarking.
+ */
+
+#ifndef FCPP_LOGIC_BENCHMARK_H_
+#define FCPP_LOGIC_BENCHMARK_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "lib/fcpp.hpp"
+#include "lib/batch_runner.hpp"
+#include "lib/export_cost.hpp"
+#include "lib/logic_samples.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+namespace tags {
+    //! @brief Index of the formula to be evaluated.
+    struct formula_id {};
+    //! @brief Probability of an atomic proposition being true in a round.
+    struct density {};
+    //! @brief Value of the formula in the current round.
+    struct verdict {};
+    //! @brief Number of rounds where the formula was false.
+    struct false_rounds {};
+    //! @brief Number of rounds where equivalent formulas disagreed.
+    struct mismatches {};
+}
+
+//! @brief Timeouts for which bounded response formulas are benchmarked.
+//! @{
+constexpr size_t short_timeout = 5;
+constexpr size_t long_timeout = 50;
+//! @}
+
+//! @brief Formula index checking equivalent formulas against each other instead of benchmarking.
+constexpr int equivalence_check = -1;
+
+//! @brief Description of a benchmarked formula.
+struct bench_formula_info {
+    //! @brief Name of the formula.
+    std::string name;
+    //! @brief Implementation variant (nested operators or fused monitor).
+    std::string variant;
+    //! @brief Static estimate of the bytes exported by the formula in a round (from its export entries).
+    std::function<size_t()> est_export_bytes;
+    //! @brief Static estimate of the bytes exported by the formula in a round once settled (as above if never settling).
+    std::function<size_t()> est_settled_bytes;
+    //! @brief Value of the formula once settled (if it ever settles).
+    bool absorbing;
+};
+
+//! @brief Description of a formula evaluated through nested operators.
+template <typename F>
+bench_formula_info nested_info(std::string name) {
+    return {name, "nested", formula_payload<F>::size, formula_payload<F>::size, false};
+}
+
+//! @brief Description of a formula evaluated through a fused monitor.
+template <typename F>
+bench_formula_info fused_info(std::string name) {
+    return {name, "fused", payload<formula::state_t<F>>::size, payload<formula::state_t<F>>::size, false};
+}
+
+//! @brief Description of a formula evaluated through operators stopping once settled.
+template <typename F>
+bench_formula_info quiescent_info(std::string name) {
+    return {name, "quiescent", quiescent_payload<F>::size, quiescent_payload<F>::settled_size, quiescent_payload<F>::absorbing};
+}
+
+//! @brief The benchmarked formulas, in the order of their index.
+inline std::vector<bench_formula_info> const& bench_formulas() {
+    using namespace logic;
+    static std::vector<bench_formula_info> v = {
+        nested_info<fused::my_unwanted_response>("my_unwanted_response"),
+        nested_info<fused::no_unwanted_response>("no_unwanted_response"),
+        nested_info<fused::my_double_request>("my_double_request"),
+        nested_info<fused::no_double_request>("no_double_request"),
+        nested_info<fused::all_response_time<short_timeout>>("all_response_time<5>/recursive"),
+        nested_info<fused::all_response_time<long_timeout>>("all_response_time<50>/recursive"),
+        {"all_response_time<5>", "nested", payload<int, bool>::size, payload<int, bool>::size, false},
+        {"all_response_time<50>", "nested", payload<int, bool>::size, payload<int, bool>::size, false},
+        nested_info<fused::my_safety_preserved>("my_safety_preserved"),
+        nested_info<fused::all_safety_preserved>("all_safety_preserved"),
+        nested_info<fused::area_handled>("area_handled"),
+        nested_info<fused::no_redundancy>("no_redundancy"),
+        nested_info<fused::active_when_present>("active_when_present"),
+        nested_info<fused::always_active_when_present>("always_active_when_present"),
+        nested_info<fused::active_when_present_twice>("active_when_present_twice"),
+        nested_info<fused::always_active_when_present_twice>("always_active_when_present_twice"),
+        fused_info<fused::my_unwanted_response>("my_unwanted_response"),
+        fused_info<fused::no_unwanted_response>("no_unwanted_response"),
+        fused_info<fused::my_double_request>("my_double_request"),
+        fused_info<fused::no_double_request>("no_double_request"),
+        fused_info<fused::all_response_time<short_timeout>>("all_response_time<5>"),
+        fused_info<fused::all_response_time<long_timeout>>("all_response_time<50>"),
+        fused_info<fused::my_safety_preserved>("my_safety_preserved"),
+        fused_info<fused::all_safety_preserved>("all_safety_preserved"),
+        fused_info<fused::area_handled>("area_handled"),
+        fused_info<fused::no_redundancy>("no_redundancy"),
+        fused_info<fused::active_when_present>("active_when_present"),
+        fused_info<fused::always_active_when_present>("always_active_when_present"),
+        fused_info<fused::active_when_present_twice>("active_when_present_twice"),
+        fused_info<fused::always_active_when_present_twice>("always_active_when_present_twice"),
+        quiescent_info<fused::no_unwanted_response>("no_unwanted_response"),
+        quiescent_info<fused::all_safety_preserved>("all_safety_preserved"),
+        quiescent_info<fused::area_handled>("area_handled"),
+        quiescent_info<fused::no_redundancy>("no_redundancy"),
+        quiescent_info<fused::always_active_when_present>("always_active_when_present"),
+        quiescent_info<fused::always_active_when_present_twice>("always_active_when_present_twice")
+    };
+    return v;
+}
+
+//! @brief Evaluates the formula of index f on atomic propositions a, b, c.
+FUN bool bench_formula(ARGS, int f, bool a, bool b, bool c) { CODE
+    using namespace logic;
+    switch (f) {
+        case 0:  return my_unwanted_response(CALL, a, b);
+        case 1:  return no_unwanted_response(CALL, a, b);
+        case 2:  return my_double_request(CALL, a, b);
+        case 3:  return no_double_request(CALL, a, b);
+        case 4:  return !EP(CALL, no_reply(CALL, a, b, short_timeout));
+        case 5:  return !EP(CALL, no_reply(CALL, a, b, long_timeout));
+        case 6:  return all_response_time(CALL, a, b, short_timeout);
+        case 7:  return all_response_time(CALL, a, b, long_timeout);
+        case 8:  return my_safety_preserved(CALL, a, b);
+        case 9:  return all_safety_preserved(CALL, a, b);
+        case 10: return area_handled(CALL, a);
+        case 11: return no_redundancy(CALL, a);
+        case 12: return active_when_present(CALL, a, b, c);
+        case 13: return always_active_when_present(CALL, a, b, c);
+        case 14: return active_when_present_twice(CALL, a, b, c);
+        case 15: return always_active_when_present_twice(CALL, a, b, c);
+        case 16: return fused_monitor<fused::my_unwanted_response>(CALL, a, b);
+        case 17: return fused_monitor<fused::no_unwanted_response>(CALL, a, b);
+        case 18: return fused_monitor<fused::my_double_request>(CALL, a, b);
+        case 19: return fused_monitor<fused::no_double_request>(CALL, a, b);
+        case 20: return fused_monitor<fused::all_response_time<short_timeout>>(CALL, a, b);
+        case 21: return fused_monitor<fused::all_response_time<long_timeout>>(CALL, a, b);
+        case 22: return fused_monitor<fused::my_safety_preserved>(CALL, a, b);
+        case 23: return fused_monitor<fused::all_safety_preserved>(CALL, a, b);
+        case 24: return fused_monitor<fused::area_handled>(CALL, a);
+        case 25: return fused_monitor<fused::no_redundancy>(CALL, a);
+        case 26: return fused_monitor<fused::active_when_present>(CALL, a, b, c);
+        case 27: return fused_monitor<fused::always_active_when_present>(CALL, a, b, c);
+        case 28: return fused_monitor<fused::active_when_present_twice>(CALL, a, b, c);
+        case 29: return fused_monitor<fused::always_active_when_present_twice>(CALL, a, b, c);
+        case 30: return quiescent::no_unwanted_response(CALL, a, b);
+        case 31: return quiescent::all_safety_preserved(CALL, a, b);
+        case 32: return quiescent::area_handled(CALL, a);
+        case 33: return quiescent::no_redundancy(CALL, a);
+        case 34: return quiescent::always_active_when_present(CALL, a, b, c);
+        default: return quiescent::always_active_when_present_twice(CALL, a, b, c);
+    }
+}
+FUN_EXPORT bench_formula_t = common::export_list<
+    logic_t,
+    quiescent_logic_t,
+    fused_monitor_t<logic::fused::my_unwanted_response>,
+    fused_monitor_t<logic::fused::no_unwanted_response>,
+    fused_monitor_t<logic::fused::my_double_request>,
+    fused_monitor_t<logic::fused::no_double_request>,
+    fused_monitor_t<logic::fused::all_response_time<short_timeout>>,
+    fused_monitor_t<logic::fused::all_response_time<long_timeout>>,
+    fused_monitor_t<logic::fused::my_safety_preserved>,
+    fused_monitor_t<logic::fused::all_safety_preserved>,
+    fused_monitor_t<logic::fused::area_handled>,
+    fused_monitor_t<logic::fused::no_redundancy>,
+    fused_monitor_t<logic::fused::active_when_present>,
+    fused_monitor_t<logic::fused::always_active_when_present>,
+    fused_monitor_t<logic::fused::active_when_present_twice>,
+    fused_monitor_t<logic::fused::always_active_when_present_twice>
+>;
+
+//! @brief Number of timeouts for which the constant-size `all_response_time` differs from its recursive definition.
+FUN size_t response_time_mismatches(ARGS, bool req, bool resp) { CODE
+    using namespace logic;
+    size_t m = 0;
+    m += all_response_time(CALL, req, resp, short_timeout) != !EP(CALL, no_reply(CALL, req, resp, short_timeout));
+    m += all_response_time(CALL, req, resp, long_timeout) != !EP(CALL, no_reply(CALL, req, resp, long_timeout));
+    return m;
+}
+FUN_EXPORT response_time_mismatches_t = common::export_list<logic_t>;
+
+//! @brief Formula benchmark on random atomic propositions.
+MAIN() {
+    using namespace tags;
+
+    count_round(CALL);
+    real_t d = node.storage(density{});
+    bool a = node.next_real() < d;
+    bool b = node.next_real() < d;
+    bool c = node.next_real() < d;
+    int f = node.storage(formula_id{});
+    if (f == equivalence_check)
+        node.storage(mismatches{}) += response_time_mismatches(CALL, a, b);
+    else {
+        bool v = bench_formula(CALL, f, a, b, c);
+        node.storage(verdict{}) = v;
+        node.storage(false_rounds{}) += not v;
+    }
+}
+FUN_EXPORT main_t = common::export_list<bench_formula_t, response_time_mismatches_t>;
+
+}
+
+//! @brief Namespace for all the simulation options.
+namespace option {
+
+using namespace component::tags;
+using namespace coordination::tags;
+
+//! @brief Dimensionality of the space.
+constexpr size_t dim = 2;
+
+//! @brief Number of rounds performed by every node.
+constexpr size_t end_time = 100;
+
+//! @brief Description of the round schedule (synchronous, to measure every node-round).
+using round_s = sequence::periodic_n<1, 0, 1, end_time-1>;
+
+//! @brief Storage tags and types.
+using storage_t = tuple_store<
+    formula_id,                     int,
+    density,                        real_t,
+    verdict,                        bool,
+    false_rounds,                   size_t,
+    mismatches,                     size_t,
+    round_count,                    size_t
+>;
+
+//! @brief Options list.
+template <bool parallel_flag>
+DECLARE_OPTIONS(list,
+    parallel<parallel_flag>,
+    synchronised<false>,
+    dimension<dim>,
+    program<coordination::main>,
+    exports<coordination::main_t>,
+    retain<metric::retain<2,1>>,
+    connector<connect::fixed<1, 1, dim>>,
+    round_schedule<round_s>,
+    storage_t
+);
+
+}
+
+}
+
+#endif // FCPP_LOGIC_BENCHMARK_H_
@@ -10,6 +10,9 @@
 
 #include "lib/beautify.hpp"
 #include "lib/coordination/past_ctl.hpp"
+#include "lib/fused_logic.hpp"
+#include "lib/packed_logic.hpp"
+#include "lib/quiescent_logic.hpp"
 
 
 /**
@@ -21,7 +24,11 @@ namespace fcpp {
 namespace coordination {
 
 //! @brief The types used in export in the logic namespace.
-FUN_EXPORT logic_t = common::export_list<bool>;
+FUN_EXPORT logic_t = common::export_list<bool, int>;
+
+//! @brief The types used in export in the logic namespace, for packed formulas on N propositions.
+template <size_t N>
+FUN_EXPORT packed_samples_t = common::export_list<packed_logic_t<N>, std::array<int, N>>;
 
 //! @brief Namespace containing logical operators and formulas.
 namespace logic {
@@ -54,9 +61,90 @@ FUN bool no_reply(ARGS, bool req, bool resp, size_t n) { CODE
         return (!resp & Y(CALL, no_reply(CALL, req, resp, n-1)));
 }
 
+//! @brief Updates the rounds elapsed since the earliest request without reply (-1 if none, saturating after n).
+inline int pending_update(int c, bool req, bool resp, size_t n) {
+    if (c >= 0 and c <= int(n)) ++c;
+    if (resp) c = -1;
+    if (req and c < 0) c = 0;
+    return c;
+}
+
+//! @brief Rounds elapsed since the earliest request without reply (-1 if none, saturating after n).
+FUN int pending_time(ARGS, bool req, bool resp, size_t n) { CODE
+    return old(CALL, -1, [&](int c){
+        return pending_update(c, req, resp, n);
+    });
+}
+
+/**
+ * @brief No reply for n rounds after the earliest pending request, with state constant in n.
+ *
+ * Coincides with `no_reply` unless a request is repeated while another is pending, and
+ * becomes true whenever `no_reply` becomes true for the first time since the last reply.
+ */
+FUN bool late_reply(ARGS, bool req, bool resp, size_t n) { CODE
+    return pending_time(CALL, req, resp, n) == int(n);
+}
+
 //! @brief Response comes always within n rounds.
 FUN bool all_response_time(ARGS, bool req, bool resp, size_t n) { CODE
-    return !EP(CALL, no_reply(CALL, req, resp, n));
+    return !EP(CALL, late_reply(CALL, req, resp, n));
+}
+
+
+//! @brief Response without corresponding request in the current round (for every request type).
+template <typename node_t, size_t N>
+packed_bits<N> my_unwanted_response(ARGS, packed_bits<N> const& req, packed_bits<N> const& resp) { CODE
+    return resp & ~Y(CALL, S(CALL, ~resp, req));
+}
+
+//! @brief No response without corresponding request (for every request type).
+template <typename node_t, size_t N>
+packed_bits<N> no_unwanted_response(ARGS, packed_bits<N> const& req, packed_bits<N> const& resp) { CODE
+    return AH(CALL, ~resp | Y(CALL, S(CALL, ~resp, req)));
+}
+
+//! @brief Making a second request before receiving a response in the current round (for every request type).
+template <typename node_t, size_t N>
+packed_bits<N> my_double_request(ARGS, packed_bits<N> const& req, packed_bits<N> const& resp) { CODE
+    return Y(CALL, S(CALL, ~resp, req)) & req;
+}
+
+//! @brief No second request before receiving a response (for every request type).
+template <typename node_t, size_t N>
+packed_bits<N> no_double_request(ARGS, packed_bits<N> const& req, packed_bits<N> const& resp) { CODE
+    return ~EP(CALL, Y(CALL, S(CALL, ~resp, req)) & req);
+}
+
+//! @brief No reply for n round after a request (for every request type).
+template <typename node_t, size_t N>
+packed_bits<N> no_reply(ARGS, packed_bits<N> const& req, packed_bits<N> const& resp, size_t n) { CODE
+    if (n==0)
+        return req;
+    else
+        return ~resp & Y(CALL, no_reply(CALL, req, resp, n-1));
+}
+
+//! @brief No reply for n rounds after the earliest pending request, with state constant in n (for every request type).
+template <typename node_t, size_t N>
+packed_bits<N> late_reply(ARGS, packed_bits<N> const& req, packed_bits<N> const& resp, size_t n) { CODE
+    std::array<int, N> init;
+    init.fill(-1);
+    std::array<int, N> c = old(CALL, init, [&](std::array<int, N> c){
+        for (size_t i=0; i<N; ++i)
+            c[i] = pending_update(c[i], req[i], resp[i], n);
+        return c;
+    });
+    packed_bits<N> r;
+    for (size_t i=0; i<N; ++i)
+        r.set(i, c[i] == int(n));
+    return r;
+}
+
+//! @brief Response comes always within n rounds (for every request type).
+template <typename node_t, size_t N>
+packed_bits<N> all_response_time(ARGS, packed_bits<N> const& req, packed_bits<N> const& resp, size_t n) { CODE
+    return ~EP(CALL, late_reply(CALL, req, resp, n));
 }
 
 
@@ -102,6 +190,126 @@ FUN bool always_active_when_present_twice(ARGS, bool s, bool a, bool p) { CODE
     return AH(CALL, active_when_present_twice(CALL, s, a, p));
 }
 
+
+//! @brief Namespace containing the formulas above through operators stopping once settled (see `quiescent_AH`).
+namespace quiescent {
+
+//! @brief No response without corresponding request.
+FUN bool no_unwanted_response(ARGS, bool req, bool resp) { CODE
+    return quiescent_AH(CALL, [&](){
+        return resp <= Y(CALL, S(CALL, !resp, req));
+    });
+}
+
+//! @brief During alert, once safe stays safe.
+FUN bool all_safety_preserved(ARGS, bool safe, bool alert) { CODE
+    return quiescent_AH(CALL, [&](){
+        return Y(CALL, safe & alert) <= (safe | !alert);
+    });
+}
+
+//! @brief Area is eventually handled.
+FUN bool area_handled(ARGS, bool handling) { CODE
+    return quiescent_EP(CALL, [&](){
+        return handling;
+    });
+}
+
+//! @brief Drones don't handle if area handled (first form).
+FUN bool no_redundancy(ARGS, bool handling) { CODE
+    return quiescent_AH(CALL, [&](){
+        return !(handling & EY(CALL, area_handled(CALL, handling)));
+    });
+}
+
+//! @brief System is active whenever proximity.
+FUN bool always_active_when_present(ARGS, bool s, bool a, bool p) { CODE
+    return quiescent_AH(CALL, [&](){
+        return active_when_present(CALL, s, a, p);
+    });
+}
+
+//! @brief System is active whenever proximity consistent for two rounds.
+FUN bool always_active_when_present_twice(ARGS, bool s, bool a, bool p) { CODE
+    return quiescent_AH(CALL, [&](){
+        return active_when_present_twice(CALL, s, a, p);
+    });
+}
+
+}
+
+
+//! @brief Namespace containing the formulas above as types, to be evaluated through `fused_monitor`.
+namespace fused {
+
+//! @cond INTERNAL
+namespace details {
+    template <size_t n>
+    struct no_reply {
+        using type = formula::conj<formula::neg<formula::prop<1>>, formula::Y<typename no_reply<n-1>::type>>;
+    };
+    template <>
+    struct no_reply<0> {
+        using type = formula::prop<0>;
+    };
+}
+//! @endcond
+
+//! @brief A request (prop. 0) is pending since no response (prop. 1) arrived.
+using pending = formula::Y<formula::S<formula::neg<formula::prop<1>>, formula::prop<0>>>;
+
+//! @brief Response without corresponding request in the current round.
+using my_unwanted_response = formula::neg<formula::impl<formula::prop<1>, pending>>;
+
+//! @brief No response without corresponding request.
+using no_unwanted_response = formula::AH<formula::impl<formula::prop<1>, pending>>;
+
+//! @brief Making a second request before receiving a response in the current round.
+using my_double_request = formula::conj<pending, formula::prop<0>>;
+
+//! @brief No second request before receiving a response.
+using no_double_request = formula::neg<formula::EP<my_double_request>>;
+
+//! @brief No reply for n round after a request.
+template <size_t n>
+using no_reply = typename details::no_reply<n>::type;
+
+//! @brief Response comes always within n rounds.
+template <size_t n>
+using all_response_time = formula::neg<formula::EP<no_reply<n>>>;
+
+//! @brief Safety was kept since the previous round (props. safe and alert).
+using safety_kept = formula::impl<formula::Y<formula::conj<formula::prop<0>, formula::prop<1>>>, formula::disj<formula::prop<0>, formula::neg<formula::prop<1>>>>;
+
+//! @brief During alert, once safe stays safe.
+using my_safety_preserved = formula::H<safety_kept>;
+
+//! @brief During alert, once safe stays safe.
+using all_safety_preserved = formula::AH<safety_kept>;
+
+//! @brief Area is eventually handled.
+using area_handled = formula::EP<formula::prop<0>>;
+
+//! @brief Drones don't handle if area handled (first form).
+using no_redundancy = formula::AH<formula::neg<formula::conj<formula::prop<0>, formula::EY<area_handled>>>>;
+
+//! @brief System is active whenever proximity (props. s, a, p).
+using active_when_present = formula::impl<formula::prop<0>, formula::iff<formula::prop<2>, formula::prop<1>>>;
+
+//! @brief System is active whenever proximity.
+using always_active_when_present = formula::AH<active_when_present>;
+
+//! @brief System is active whenever proximity consistent for two rounds.
+using active_when_present_twice = formula::impl<formula::prop<0>, formula::conj<
+    formula::impl<formula::conj<formula::prop<2>, formula::Y<formula::prop<2>>>, formula::prop<1>>,
+    formula::impl<formula::conj<formula::neg<formula::prop<2>>, formula::Y<formula::neg<formula::prop<2>>>>, formula::neg<formula::prop<1>>>
+>>;
+
+//! @brief System is active whenever proximity consistent for two rounds.
+using always_active_when_present_twice = formula::AH<active_when_present_twice>;
+
+}
+
 }
 
 }
@@ -0,0 +1,111 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file mapped_file.hpp
+ * @brief Read-only access to binary files, mapped in memory whenever possible.
+ */
+
+#ifndef FCPP_MAPPED_FILE_H_
+#define FCPP_MAPPED_FILE_H_
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Content of a binary file, mapped in memory whenever possible.
+class mapped_file {
+  public:
+    //! @brief Opens a file.
+    mapped_file(std::string const& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open file " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat file " + path);
+        }
+        m_size = st.st_size;
+        m_data = nullptr;
+        // empty files cannot be mapped, and have no content to map
+        if (m_size > 0) {
+            void* p = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map file " + path);
+            }
+            m_data = static_cast<char const*>(p);
+        }
+        ::close(fd);
+#else
+        FILE* f = std::fopen(path.c_str(), "rb");
+        if (f == nullptr) throw std::runtime_error("cannot open file " + path);
+        std::fseek(f, 0, SEEK_END);
+        m_buffer.resize(std::ftell(f));
+        std::fseek(f, 0, SEEK_SET);
+        m_buffer.resize(std::fread(m_buffer.data(), 1, m_buffer.size(), f));
+        std::fclose(f);
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+#endif
+    }
+
+    //! @brief Unmaps the file.
+    ~mapped_file() {
+#ifndef _WIN32
+        if (m_size > 0) munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    //! @brief The content of the file (null if empty).
+    char const* data() const {
+        return m_data;
+    }
+
+    //! @brief The size of the file.
+    size_t size() const {
+        return m_size;
+    }
+
+    //! @brief Reads a value at a given position (which may be unaligned).
+    template <typename T>
+    T read(size_t pos) const {
+        T x;
+        std::memcpy(&x, m_data + pos, sizeof(T));
+        return x;
+    }
+
+  private:
+    //! @brief The content of the file.
+    char const* m_data;
+
+    //! @brief The size of the file.
+    size_t m_size;
+
+#ifdef _WIN32
+    //! @brief The file content (where memory mapping is not available).
+    std::vector<char> m_buffer;
+#endif
+};
+
+}
+
+#endif // FCPP_MAPPED_FILE_H_
@@ -0,0 +1,194 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file monitor_flags.hpp
+ * @brief Runtime-sized arrays of monitor flags, and their column-wise aggregation.
+ */
+
+#ifndef FCPP_MONITOR_FLAGS_H_
+#define FCPP_MONITOR_FLAGS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+/**
+ * @brief Contiguous array of monitor flags (e.g. one per request type or area), sized at runtime.
+ *
+ * Flags are packed in machine words, and the array grows as flags are set.
+ */
+class monitor_flags {
+  public:
+    //! @brief Default constructor (no flags).
+    monitor_flags() = default;
+
+    //! @brief Constructor with a given number of flags (all false).
+    monitor_flags(size_t n) : m_size(n), m_data((n + 63) / 64, 0) {}
+
+    //! @brief Number of flags.
+    size_t size() const {
+        return m_size;
+    }
+
+    //! @brief Resizes the array (new flags are false).
+    void resize(size_t n) {
+        m_data.resize((n + 63) / 64, 0);
+        if (n < m_size and n % 64) m_data.back() &= (uint64_t(1) << (n % 64)) - 1;
+        m_size = n;
+    }
+
+    //! @brief Sets the i-th flag (growing the array if needed).
+    monitor_flags& set(size_t i, bool v = true) {
+        if (i >= m_size) resize(i + 1);
+        m_data[i / 64] = (m_data[i / 64] & ~(uint64_t(1) << (i % 64))) | (uint64_t(v) << (i % 64));
+        return *this;
+    }
+
+    //! @brief Reads the i-th flag (false if out of range).
+    bool operator[](size_t i) const {
+        return i < m_size and (m_data[i / 64] >> (i % 64)) & 1;
+    }
+
+    //! @brief Number of flags set.
+    size_t count() const {
+        size_t c = 0;
+        for (uint64_t w : m_data) c += __builtin_popcountll(w);
+        return c;
+    }
+
+    //! @brief The packed words.
+    std::vector<uint64_t> const& words() const {
+        return m_data;
+    }
+
+    //! @brief Equality.
+    friend bool operator==(monitor_flags const& x, monitor_flags const& y) {
+        return x.m_size == y.m_size and x.m_data == y.m_data;
+    }
+
+    //! @brief Inequality.
+    friend bool operator!=(monitor_flags const& x, monitor_flags const& y) {
+        return not (x == y);
+    }
+
+    //! @brief Serialises the content from/to a given input/output stream.
+    template <typename S>
+    S& serialize(S& s) {
+        return s & m_size & m_data;
+    }
+
+    //! @brief Serialises the content from/to a given input/output stream (const overload).
+    template <typename S>
+    S& serialize(S& s) const {
+        return s << m_size << m_data;
+    }
+
+  private:
+    //! @brief The number of flags.
+    size_t m_size = 0;
+
+    //! @brief The packed flags.
+    std::vector<uint64_t> m_data;
+};
+
+//! @brief Namespace for aggregators.
+namespace aggregator {
+
+//! @brief Tag for the fraction of flags set, averaged over flags.
+template <typename T>
+struct flags_mean {};
+
+//! @brief Tag for the fraction of flags set, in the flag where it is largest.
+template <typename T>
+struct flags_max {};
+
+/**
+ * @brief Column-wise aggregation of monitor flags.
+ *
+ * Counts how many devices have every flag set, word by word with branch-free loops (which compilers
+ * vectorise), and yields the fraction of devices with a flag set, both averaged over the flags and
+ * in the worst flag.
+ */
+class flags {
+  public:
+    //! @brief The type of values aggregated.
+    using type = monitor_flags;
+
+    //! @brief The type of the aggregation result, given the tag of the aggregated values.
+    template <typename U>
+    using result_type = common::tagged_tuple_t<flags_mean<U>, double, flags_max<U>, double>;
+
+    //! @brief Default constructor.
+    flags() = default;
+
+    //! @brief Combines aggregated values.
+    flags& operator+=(flags const& o) {
+        if (o.m_counts.size() > m_counts.size()) m_counts.resize(o.m_counts.size(), 0);
+        for (size_t i = 0; i < o.m_counts.size(); ++i) m_counts[i] += o.m_counts[i];
+        m_devices += o.m_devices;
+        return *this;
+    }
+
+    //! @brief Inserts a new value to be aggregated.
+    void insert(monitor_flags const& value) {
+        add(value, 1);
+        ++m_devices;
+    }
+
+    //! @brief Erases a value from the aggregation set.
+    void erase(monitor_flags const& value) {
+        add(value, -1);
+        --m_devices;
+    }
+
+    //! @brief The results of aggregation.
+    template <typename U>
+    result_type<U> result() const {
+        if (m_devices == 0 or m_counts.empty()) return {0, 0};
+        int64_t total = 0, worst = 0;
+        for (int64_t c : m_counts) {
+            total += c;
+            worst = std::max(worst, c);
+        }
+        return {double(total) / m_devices / m_counts.size(), double(worst) / m_devices};
+    }
+
+    //! @brief The name of the aggregator.
+    static std::string name() {
+        return "flags";
+    }
+
+  private:
+    //! @brief Adds d to the counts of the flags set in a value.
+    void add(monitor_flags const& value, int64_t d) {
+        if (value.size() > m_counts.size()) m_counts.resize(value.size(), 0);
+        std::vector<uint64_t> const& w = value.words();
+        for (size_t k = 0; k < w.size(); ++k) {
+            int64_t* c = m_counts.data() + 64 * k;
+            size_t n = std::min(size_t(64), value.size() - 64 * k);
+            for (size_t b = 0; b < n; ++b)
+                c[b] += d * int64_t((w[k] >> b) & 1);
+        }
+    }
+
+    //! @brief Number of devices with every flag set.
+    std::vector<int64_t> m_counts;
+
+    //! @brief Number of devices aggregated.
+    int64_t m_devices = 0;
+};
+
+}
+
+}
+
+#endif // FCPP_MONITOR_FLAGS_H_
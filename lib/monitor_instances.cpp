@@ -0,0 +1,42 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file monitor_instances.cpp
+ * @brief Single instantiation of the monitor code not depending on the node type (with `FCPP_MULTI_RUNNER`).
+ *
+ * Aggregate functions are templates on the node type, which depends on the options of each case study,
+ * so they are compiled with it. The classes and functions below do not depend on it: their headers
+ * declare them `extern` with `FCPP_MULTI_RUNNER`, so that the other translation units link them from
+ * here instead of compiling them again. In particular, the replay and reference monitors of every
+ * sample formula, with their fused evaluators, are only compiled here.
+ */
+
+#include "lib/streaming_monitor.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+template class packed_bits<1>;
+template class packed_bits<2>;
+template class packed_bits<3>;
+template class packed_bits<4>;
+template class packed_bits<5>;
+template class packed_bits<6>;
+
+namespace aggregator {
+    template class first_true<times_t>;
+    template class sketch<real_t, 50, 95, 99>;
+    template class run_sketch<real_t, 50, 95, 99>;
+}
+
+namespace streaming {
+    template std::map<std::string, factory_t> const& formulas<proposition_trace::replay_monitor>();
+    template std::map<std::string, factory_t> const& formulas<proposition_trace::reference_monitor>();
+    template std::unique_ptr<proposition_trace::replay_base> make_monitor<proposition_trace::replay_monitor>(std::string const&, size_t);
+    template std::unique_ptr<proposition_trace::replay_base> make_monitor<proposition_trace::reference_monitor>(std::string const&, size_t);
+}
+
+}
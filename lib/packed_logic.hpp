@@ -0,0 +1,225 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file packed_logic.hpp
+ * @brief Implementation of Past-CTL operators over packed sets of propositions.
+ */
+
+#ifndef FCPP_PACKED_LOGIC_H_
+#define FCPP_PACKED_LOGIC_H_
+
+#include <array>
+#include <cstdint>
+
+#include "lib/beautify.hpp"
+#include "lib/coordination/past_ctl.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+/**
+ * @brief Fixed-size set of boolean propositions, packed in machine words.
+ *
+ * Logical operators act on every proposition at once, word by word.
+ *
+ * @param N The number of propositions.
+ */
+template <size_t N>
+class packed_bits {
+    //! @brief The number of words used.
+    static constexpr size_t words = (N + 63) / 64;
+
+    //! @brief Mask of the bits in use in the last word.
+    static constexpr uint64_t last_mask = N % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (N % 64)) - 1;
+
+  public:
+    //! @brief Default constructor (all propositions false).
+    packed_bits() : m_data{} {}
+
+    //! @brief Constructor setting all propositions to a given value.
+    explicit packed_bits(bool b) : m_data{} {
+        if (b) {
+            m_data.fill(~uint64_t(0));
+            m_data[words-1] &= last_mask;
+        }
+    }
+
+    //! @brief Number of propositions.
+    static constexpr size_t size() {
+        return N;
+    }
+
+    //! @brief Reads the value of the i-th proposition.
+    bool operator[](size_t i) const {
+        return (m_data[i / 64] >> (i % 64)) & 1;
+    }
+
+    //! @brief Sets the value of the i-th proposition.
+    packed_bits& set(size_t i, bool b) {
+        uint64_t bit = uint64_t(1) << (i % 64);
+        m_data[i / 64] = b ? m_data[i / 64] | bit : m_data[i / 64] & ~bit;
+        return *this;
+    }
+
+    //! @brief Whether some proposition is true.
+    bool any() const {
+        for (uint64_t w : m_data) if (w) return true;
+        return false;
+    }
+
+    //! @brief Whether every proposition is true.
+    bool all() const {
+        return *this == packed_bits(true);
+    }
+
+    //! @brief Whether every proposition is false.
+    bool none() const {
+        return not any();
+    }
+
+    //! @brief Negation.
+    packed_bits operator~() const {
+        packed_bits r;
+        for (size_t i = 0; i < words; ++i) r.m_data[i] = ~m_data[i];
+        r.m_data[words-1] &= last_mask;
+        return r;
+    }
+
+    //! @brief Conjunction.
+    packed_bits& operator&=(packed_bits const& o) {
+        for (size_t i = 0; i < words; ++i) m_data[i] &= o.m_data[i];
+        return *this;
+    }
+
+    //! @brief Disjunction.
+    packed_bits& operator|=(packed_bits const& o) {
+        for (size_t i = 0; i < words; ++i) m_data[i] |= o.m_data[i];
+        return *this;
+    }
+
+    //! @brief Exclusive disjunction.
+    packed_bits& operator^=(packed_bits const& o) {
+        for (size_t i = 0; i < words; ++i) m_data[i] ^= o.m_data[i];
+        return *this;
+    }
+
+    //! @brief Conjunction.
+    friend packed_bits operator&(packed_bits x, packed_bits const& y) {
+        return x &= y;
+    }
+
+    //! @brief Disjunction.
+    friend packed_bits operator|(packed_bits x, packed_bits const& y) {
+        return x |= y;
+    }
+
+    //! @brief Exclusive disjunction.
+    friend packed_bits operator^(packed_bits x, packed_bits const& y) {
+        return x ^= y;
+    }
+
+    //! @brief Equality.
+    friend bool operator==(packed_bits const& x, packed_bits const& y) {
+        return x.m_data == y.m_data;
+    }
+
+    //! @brief Inequality.
+    friend bool operator!=(packed_bits const& x, packed_bits const& y) {
+        return x.m_data != y.m_data;
+    }
+
+    //! @brief Serialises the content from/to a given input/output stream.
+    template <typename S>
+    S& serialize(S& s) {
+        return s & m_data;
+    }
+
+    //! @brief Serialises the content from/to a given input/output stream (const overload).
+    template <typename S>
+    S& serialize(S& s) const {
+        return s << m_data;
+    }
+
+  private:
+    //! @brief The packed propositions.
+    std::array<uint64_t, words> m_data;
+};
+
+#ifdef FCPP_MULTI_RUNNER
+//! @brief Sizes of the states of the sample formulas and of the request types of service discovery (see `lib/monitor_instances.cpp`).
+//! @{
+extern template class packed_bits<1>;
+extern template class packed_bits<2>;
+extern template class packed_bits<3>;
+extern template class packed_bits<4>;
+extern template class packed_bits<5>;
+extern template class packed_bits<6>;
+//! @}
+#endif
+
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+//! @brief The types used in export by packed operators on N propositions.
+template <size_t N>
+FUN_EXPORT packed_logic_t = common::export_list<packed_bits<N>>;
+
+//! @brief Previous-round value of every proposition (false initially).
+template <typename node_t, size_t N>
+packed_bits<N> Y(ARGS, packed_bits<N> const& f) { CODE
+    return old(CALL, packed_bits<N>(), f);
+}
+
+//! @brief Every proposition of g held since f (g or f and previously f S g).
+template <typename node_t, size_t N>
+packed_bits<N> S(ARGS, packed_bits<N> const& f, packed_bits<N> const& g) { CODE
+    return old(CALL, packed_bits<N>(), [&](packed_bits<N> const& o){
+        return g | (f & o);
+    });
+}
+
+//! @brief Every proposition has been locally true in every round.
+template <typename node_t, size_t N>
+packed_bits<N> H(ARGS, packed_bits<N> const& f) { CODE
+    return old(CALL, packed_bits<N>(true), [&](packed_bits<N> const& o){
+        return o & f;
+    });
+}
+
+//! @brief Every proposition has been true in every causal past event.
+template <typename node_t, size_t N>
+packed_bits<N> AH(ARGS, packed_bits<N> const& f) { CODE
+    return nbr(CALL, packed_bits<N>(true), [&](field<packed_bits<N>> const& o){
+        return f & fold_hood(CALL, [](packed_bits<N> const& x, packed_bits<N> const& y){
+            return x & y;
+        }, o);
+    });
+}
+
+//! @brief Every proposition has been true in some causal past event.
+template <typename node_t, size_t N>
+packed_bits<N> EP(ARGS, packed_bits<N> const& f) { CODE
+    return nbr(CALL, packed_bits<N>(), [&](field<packed_bits<N>> const& o){
+        return f | fold_hood(CALL, [](packed_bits<N> const& x, packed_bits<N> const& y){
+            return x | y;
+        }, o);
+    });
+}
+
+//! @brief Every proposition held in some causal predecessor event.
+template <typename node_t, size_t N>
+packed_bits<N> EY(ARGS, packed_bits<N> const& f) { CODE
+    return fold_hood(CALL, [](packed_bits<N> const& x, packed_bits<N> const& y){
+        return x | y;
+    }, nbr(CALL, packed_bits<N>(), f));
+}
+
+}
+
+}
+
+#endif // FCPP_PACKED_LOGIC_H_
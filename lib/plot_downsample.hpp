@@ -0,0 +1,212 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file plot_downsample.hpp
+ * @brief Shape-preserving downsampling of plots, bounding the number of points rendered.
+ *
+ * Every series of a plot is reduced through the Largest-Triangle-Three-Buckets algorithm, which
+ * keeps the points forming the largest triangles with their neighbouring buckets. Series changing
+ * value at most as many times as the point budget (such as monitors flipping) keep instead both
+ * points around every change, so that steps are rendered exactly. Since the series of a plot share
+ * their x values, a plot keeps the union of the points selected for its series.
+ *
+ * Downsampling a built plot does not bound the memory of the plotter, which holds every row logged
+ * until the plot is built. The `bounded` plotter wrapper applies the same selection to the rows as they
+ * are logged, so that only a bounded number of rows reaches the plotter whatever the run length.
+ */
+
+#ifndef FCPP_PLOT_DOWNSAMPLE_H_
+#define FCPP_PLOT_DOWNSAMPLE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Default number of points per series kept by downsampling (zero for no downsampling).
+#ifndef FCPP_PLOT_POINTS
+#define FCPP_PLOT_POINTS 1000
+#endif
+
+//! @brief Namespace for plotting.
+namespace plot {
+
+//! @brief Default number of points per series kept by downsampling (zero for no downsampling).
+constexpr size_t default_points = FCPP_PLOT_POINTS;
+
+//! @cond INTERNAL
+namespace details {
+    //! @brief Marks the points selected by LTTB on series y over x, for a budget of n points.
+    inline void lttb(std::vector<double> const& x, std::vector<double> const& y, size_t n, std::vector<bool>& keep) {
+        size_t len = y.size();
+        keep[0] = keep[len-1] = true;
+        double every = double(len - 2) / (n - 2);
+        size_t a = 0;
+        for (size_t i = 0; i < n - 2; ++i) {
+            // average point of the next bucket
+            size_t nb = std::min(size_t((i + 1) * every) + 1, len - 1);
+            size_t ne = std::min(size_t((i + 2) * every) + 1, len);
+            double ax = 0, ay = 0;
+            for (size_t j = nb; j < ne; ++j) {
+                ax += x[j];
+                ay += y[j];
+            }
+            if (ne > nb) {
+                ax /= ne - nb;
+                ay /= ne - nb;
+            } else {
+                ax = x[len-1];
+                ay = y[len-1];
+            }
+            // point of the current bucket with the largest triangle
+            size_t b = size_t(i * every) + 1, e = std::min(size_t((i + 1) * every) + 1, len - 1);
+            double best = -1;
+            size_t sel = b;
+            for (size_t j = b; j < e; ++j) {
+                double area = std::abs((x[a] - ax) * (y[j] - y[a]) - (x[a] - x[j]) * (ay - y[a]));
+                if (area > best) {
+                    best = area;
+                    sel = j;
+                }
+            }
+            keep[sel] = true;
+            a = sel;
+        }
+    }
+
+    //! @brief Marks the points to be kept of series y over x, for a budget of n points.
+    inline void downsample(std::vector<double> const& x, std::vector<double> const& y, size_t n, std::vector<bool>& keep) {
+        size_t changes = 0;
+        for (size_t i = 1; i < y.size() and changes <= n; ++i)
+            changes += y[i] != y[i-1] and not (std::isnan(y[i]) and std::isnan(y[i-1]));
+        if (changes <= n) {
+            keep[0] = keep[y.size()-1] = true;
+            for (size_t i = 1; i < y.size(); ++i)
+                if (y[i] != y[i-1] and not (std::isnan(y[i]) and std::isnan(y[i-1])))
+                    keep[i-1] = keep[i] = true;
+        } else lttb(x, y, n, keep);
+    }
+}
+//! @endcond
+
+//! @brief Downsamples a plot to at most n points per series (plus both ends of every step), unless n is zero.
+inline void downsample(plot& p, size_t n = default_points) {
+    size_t len = p.xvals.size();
+    if (n == 0 or len <= std::max(n, size_t(3))) return;
+    n = std::max(n, size_t(3));
+    std::vector<bool> keep(len, false);
+    for (auto const& y : p.yvals)
+        details::downsample(p.xvals, y.second, n, keep);
+    auto filter = [&](std::vector<double>& v){
+        size_t k = 0;
+        for (size_t i = 0; i < len; ++i)
+            if (keep[i]) v[k++] = v[i];
+        v.resize(k);
+    };
+    filter(p.xvals);
+    for (auto& y : p.yvals) filter(y.second);
+}
+
+//! @brief Downsamples every plot of a page.
+inline void downsample(page& p, size_t n = default_points) {
+    for (auto& q : p.plots) downsample(q, n);
+}
+
+//! @brief Downsamples every plot of some pages.
+inline void downsample(std::vector<page>& v, size_t n = default_points) {
+    for (auto& p : v) downsample(p, n);
+}
+
+//! @brief Returns plots (or pages) downsampled to at most n points per series.
+template <typename T>
+T downsampled(T x, size_t n = default_points) {
+    downsample(x, n);
+    return x;
+}
+
+/**
+ * @brief Plotter P receiving a bounded selection of the rows logged, downsampled as they arrive.
+ *
+ * Rows are buffered, and whenever the buffer doubles they are selected as in `downsample` (with
+ * the order of arrival as x value), to at most n points per column plus both ends of every step. The
+ * rows kept are given to P when the plot is built. Since selections are repeated on their own results,
+ * those of LTTB approximate a single selection over all the rows, while steps are kept exactly. The
+ * rows buffered are at most twice the union of the selections of every column. If n is zero, every row
+ * is kept.
+ */
+template <typename P, size_t n = default_points>
+class bounded {
+  public:
+    //! @brief Logs a row.
+    template <typename... Ss, typename... Ts>
+    bounded& operator<<(common::tagged_tuple<common::type_sequence<Ss...>, common::type_sequence<Ts...>> const& row) {
+        m_rows.push_back([row](P& p){
+            p << row;
+        });
+        if (n == 0) return *this;
+        if (m_y.empty()) m_y.resize(sizeof...(Ss));
+        m_x.push_back(m_count++);
+        size_t c = 0;
+        for (double y : {static_cast<double>(common::get<Ss>(row))...})
+            m_y[c++].push_back(y);
+        if (m_rows.size() >= m_limit) compact();
+        return *this;
+    }
+
+    //! @brief Builds the plot of the rows kept.
+    auto build() const {
+        P p;
+        for (auto const& r : m_rows) r(p);
+        return p.build();
+    }
+
+  private:
+    //! @brief Minimum budget of points.
+    static constexpr size_t budget = std::max(n, size_t(3));
+
+    //! @brief Selects the rows to be kept.
+    void compact() {
+        std::vector<bool> keep(m_rows.size(), false);
+        for (auto const& y : m_y)
+            details::downsample(m_x, y, budget, keep);
+        auto filter = [&](auto& v){
+            size_t k = 0;
+            for (size_t i = 0; i < keep.size(); ++i)
+                if (keep[i]) v[k++] = std::move(v[i]);
+            v.resize(k);
+        };
+        filter(m_rows);
+        filter(m_x);
+        for (auto& y : m_y) filter(y);
+        m_limit = 2 * std::max(budget, m_rows.size());
+    }
+
+    //! @brief The rows kept, as functions logging them into a plotter.
+    std::vector<std::function<void(P&)>> m_rows;
+
+    //! @brief Order of arrival of the rows kept.
+    std::vector<double> m_x;
+
+    //! @brief Values of every column in the rows kept.
+    std::vector<std::vector<double>> m_y;
+
+    //! @brief Number of rows logged.
+    size_t m_count = 0;
+
+    //! @brief Number of rows kept triggering the next selection.
+    size_t m_limit = 2 * budget;
+};
+
+}
+
+}
+
+#endif // FCPP_PLOT_DOWNSAMPLE_H_
@@ -0,0 +1,242 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file profiler.hpp
+ * @brief Opt-in attribution of wall time and calls to aggregate code, keyed by its call path.
+ *
+ * When `FCPP_PROFILE` is defined, `PROFILE_SCOPE(name)` opens a profiling scope until the end of the
+ * enclosing block, in an aggregate function (after `CODE`, at most one per function) or in a `MAIN`.
+ * Case studies open one in `MAIN`, and `export_cost` opens one for every call it wraps, named after
+ * its tag. A scope is keyed by the hash of the stack trace of the node, which already identifies its
+ * call path. Scopes form a tree of call paths in every thread, where they accumulate the number of
+ * calls and the time spent, read from the time-stamp counter where available. At the end of a run, the
+ * paths of all threads are merged by name into a report in the folded format of flame graphs (one line
+ * per path, with the time spent in it excluding callees, in microseconds), and into a summary of the
+ * scopes by total time. Otherwise, `PROFILE_SCOPE` expands to nothing.
+ */
+
+#ifndef FCPP_PROFILER_H_
+#define FCPP_PROFILER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace for profiling aggregate functions.
+namespace profiler {
+
+//! @brief Current value of the time-stamp counter (or of a steady clock in nanoseconds where not available).
+inline uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+//! @cond INTERNAL
+namespace details {
+    //! @brief A call path in the tree of a thread.
+    struct frame {
+        //! @brief The name of the scope.
+        char const* name;
+        //! @brief Index of the parent path.
+        size_t parent;
+        //! @brief Number of calls.
+        uint64_t calls;
+        //! @brief Ticks spent in the calls (callees included).
+        uint64_t ticks;
+        //! @brief Indices of the paths extending this one.
+        std::vector<size_t> children;
+    };
+
+    //! @brief The tree of call paths of a thread.
+    struct tree {
+        //! @brief The call paths (the first one being the empty path).
+        std::vector<frame> frames{frame{"", 0, 0, 0, {}}};
+        //! @brief Index of the call paths by the hash of their stack trace.
+        std::unordered_map<trace_t, size_t> index;
+        //! @brief Index of the path currently open.
+        size_t current = 0;
+    };
+
+    //! @brief Global state of the profiler.
+    struct registry {
+        //! @brief Constructor, sampling the clocks for calibration.
+        registry() : start_ticks(ticks()), start_time(std::chrono::steady_clock::now()) {}
+        //! @brief Ticks at the start of the process.
+        uint64_t start_ticks;
+        //! @brief Time at the start of the process.
+        std::chrono::steady_clock::time_point start_time;
+        //! @brief The trees of every thread (kept after threads exit).
+        std::vector<std::shared_ptr<tree>> trees;
+        //! @brief Mutex guarding the list of trees.
+        std::mutex mutex;
+    };
+
+    //! @brief The global state of the profiler.
+    inline registry& global() {
+        static registry r;
+        return r;
+    }
+
+    //! @brief The tree of the current thread.
+    inline tree& local() {
+        thread_local tree* t = [](){
+            registry& r = global();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.trees.push_back(std::make_shared<tree>());
+            return r.trees.back().get();
+        }();
+        return *t;
+    }
+
+}
+//! @endcond
+
+//! @brief Name of a type T in profiles (without namespaces).
+template <typename T>
+char const* name_of() {
+    static std::string const s = common::strip_namespaces(common::type_name<T>());
+    return s.c_str();
+}
+
+//! @brief Profiling scope of a call, open until destruction.
+class scope {
+  public:
+    //! @brief Opens a scope with a given name, at a call path with a given stack trace hash.
+    scope(trace_t key, char const* name) : m_tree(details::local()) {
+        std::vector<details::frame>& f = m_tree.frames;
+        size_t p = m_tree.current;
+        auto it = m_tree.index.emplace(key, f.size()).first;
+        if (it->second == f.size()) {
+            f.push_back(details::frame{name, p, 0, 0, {}});
+            f[p].children.push_back(it->second);
+        }
+        m_tree.current = it->second;
+        m_start = ticks();
+    }
+
+    //! @brief Closes the scope.
+    ~scope() {
+        details::frame& f = m_tree.frames[m_tree.current];
+        f.ticks += ticks() - m_start;
+        ++f.calls;
+        m_tree.current = f.parent;
+    }
+
+    scope(scope const&) = delete;
+    scope& operator=(scope const&) = delete;
+
+  private:
+    //! @brief The tree of the thread.
+    details::tree& m_tree;
+
+    //! @brief Ticks at the opening of the scope.
+    uint64_t m_start;
+};
+
+//! @brief Calls and time (in seconds) spent along a call path.
+struct entry {
+    //! @brief Number of calls.
+    uint64_t calls = 0;
+    //! @brief Time spent (callees included).
+    double total = 0;
+    //! @brief Time spent (callees excluded).
+    double self = 0;
+};
+
+/**
+ * @brief Profile of the calls so far, by call path (names separated by semicolons), merging all threads.
+ *
+ * Should be called while no thread is running aggregate functions.
+ */
+inline std::map<std::string, entry> paths() {
+    details::registry& r = details::global();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - r.start_time).count();
+    double tick = secs / std::max(ticks() - r.start_ticks, uint64_t(1));
+    std::map<std::string, entry> m;
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto const& t : r.trees) {
+        std::vector<details::frame> const& f = t->frames;
+        std::vector<std::string> names(f.size());
+        for (size_t i = 1; i < f.size(); ++i) {
+            names[i] = (f[i].parent ? names[f[i].parent] + ";" : "") + f[i].name;
+            entry& e = m[names[i]];
+            uint64_t inner = 0;
+            for (size_t c : f[i].children) inner += f[c].ticks;
+            e.calls += f[i].calls;
+            e.total += f[i].ticks * tick;
+            e.self += (f[i].ticks - std::min(inner, f[i].ticks)) * tick;
+        }
+    }
+    return m;
+}
+
+//! @brief Clears the calls profiled so far (while no thread is running aggregate functions).
+inline void reset() {
+    details::registry& r = details::global();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto const& t : r.trees)
+        for (details::frame& f : t->frames) f.calls = f.ticks = 0;
+}
+
+//! @brief Writes the profile in the folded format of flame graphs (self time in microseconds).
+inline void folded(std::ostream& out) {
+    for (auto const& p : paths())
+        if (p.second.calls) out << p.first << " " << uint64_t(p.second.self * 1e6 + 0.5) << "\n";
+}
+
+//! @brief Writes a summary of the scopes by total time (recursive calls counted once per path).
+inline void summary(std::ostream& out, size_t top = 20) {
+    std::map<std::string, entry> m;
+    for (auto const& p : paths()) {
+        size_t s = p.first.rfind(';');
+        entry& e = m[s == std::string::npos ? p.first : p.first.substr(s + 1)];
+        e.calls += p.second.calls;
+        e.total += p.second.total;
+        e.self += p.second.self;
+    }
+    std::vector<std::pair<std::string, entry>> v(m.begin(), m.end());
+    std::sort(v.begin(), v.end(), [](auto const& x, auto const& y){
+        return x.second.total > y.second.total;
+    });
+    out << "scope\tcalls\ttotal (s)\tself (s)\tns/call\n";
+    for (size_t i = 0; i < std::min(top, v.size()); ++i)
+        if (v[i].second.calls)
+            out << v[i].first << "\t" << v[i].second.calls << "\t" << v[i].second.total << "\t" << v[i].second.self << "\t" << v[i].second.total * 1e9 / v[i].second.calls << "\n";
+}
+
+}
+
+}
+
+#ifdef FCPP_PROFILE
+//! @brief Opens a profiling scope with a given name until the end of the enclosing block.
+#define PROFILE_SCOPE(name) fcpp::profiler::scope profiler_scope(node.stack_trace.hash(0), name)
+#else
+//! @brief Opens a profiling scope with a given name (nothing, profiling disabled).
+#define PROFILE_SCOPE(name)
+#endif
+
+#endif // FCPP_PROFILER_H_
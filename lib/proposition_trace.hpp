@@ -0,0 +1,315 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file proposition_trace.hpp
+ * @brief Recording of atomic propositions and neighbourhoods, and offline replay of monitors on them.
+ *
+ * A trace file starts with a header (the magic `PCTL`, a version and the number of propositions),
+ * followed by a record for every round of every node: its time (`double`), its UID and number of
+ * neighbours (`uint32_t`), its propositions as a bitmask (`uint64_t`) and the UIDs of its neighbours
+ * (`uint32_t` each). Records are stored in the order rounds were executed.
+ */
+
+#ifndef FCPP_PROPOSITION_TRACE_H_
+#define FCPP_PROPOSITION_TRACE_H_
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/fcpp.hpp"
+#include "lib/fused_logic.hpp"
+#include "lib/mapped_file.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace for recording and replaying traces of atomic propositions.
+namespace proposition_trace {
+
+//! @brief Magic string at the start of a trace file.
+constexpr char magic[4] = {'P', 'C', 'T', 'L'};
+
+//! @brief Version of the trace format.
+constexpr uint32_t version = 1;
+
+//! @brief Maximum number of propositions in a trace.
+constexpr size_t max_props = 64;
+
+//! @brief Writer of traces, shared by all the nodes of a process.
+class recorder {
+  public:
+    //! @brief The recorder of the process.
+    static recorder& instance() {
+        static recorder r;
+        return r;
+    }
+
+    //! @brief Starts recording to a file, with a given number of propositions.
+    void open(std::string const& path, uint32_t nprops) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (nprops > max_props) throw std::invalid_argument("too many propositions in trace");
+        m_file = std::fopen(path.c_str(), "wb");
+        if (m_file == nullptr) throw std::runtime_error("cannot open trace file " + path);
+        std::fwrite(magic, 1, 4, m_file);
+        write(version);
+        write(nprops);
+    }
+
+    //! @brief Stops recording.
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_file) std::fclose(m_file);
+        m_file = nullptr;
+    }
+
+    //! @brief Whether the recorder is active.
+    bool active() const {
+        return m_file != nullptr;
+    }
+
+    //! @brief Records a round of a node.
+    void record(double time, uint32_t uid, uint64_t props, std::vector<uint32_t> const& nbrs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_file == nullptr) return;
+        write(time);
+        write(uid);
+        write(uint32_t(nbrs.size()));
+        write(props);
+        std::fwrite(nbrs.data(), sizeof(uint32_t), nbrs.size(), m_file);
+    }
+
+    //! @brief Destructor, flushing the file.
+    ~recorder() {
+        close();
+    }
+
+  private:
+    //! @brief Writes a value to the file.
+    template <typename T>
+    void write(T x) {
+        std::fwrite(&x, sizeof(T), 1, m_file);
+    }
+
+    //! @brief The file being written.
+    FILE* m_file = nullptr;
+
+    //! @brief Mutex serialising writes from different threads.
+    std::mutex m_mutex;
+};
+
+//! @brief Reader of a trace file, mapped in memory whenever possible.
+class reader {
+  public:
+    //! @brief A round of a node, as recorded in the trace.
+    struct record {
+        //! @brief Time of the round.
+        double time;
+        //! @brief UID of the node.
+        uint32_t uid;
+        //! @brief Propositions of the node in the round.
+        uint64_t props;
+        //! @brief Number of neighbours.
+        uint32_t nnbrs;
+        //! @brief Pointer to the (possibly unaligned) UIDs of neighbours.
+        char const* nbrs;
+
+        //! @brief UID of the i-th neighbour.
+        uint32_t nbr(size_t i) const {
+            uint32_t x;
+            std::memcpy(&x, nbrs + i * sizeof(uint32_t), sizeof(uint32_t));
+            return x;
+        }
+    };
+
+    //! @brief Opens a trace file.
+    reader(std::string const& path) : m_file(path) {
+        if (m_file.size() < 12 or std::memcmp(m_file.data(), magic, 4) != 0 or m_file.read<uint32_t>(4) != version)
+            throw std::runtime_error("invalid trace file " + path);
+        m_nprops = m_file.read<uint32_t>(8);
+    }
+
+    //! @brief Number of propositions in the trace.
+    uint32_t props() const {
+        return m_nprops;
+    }
+
+    //! @brief Calls f on every record of the trace, in order.
+    template <typename G>
+    void for_each(G&& f) const {
+        constexpr size_t head = sizeof(double) + 2 * sizeof(uint32_t) + sizeof(uint64_t);
+        for (size_t pos = 12; pos + head <= m_file.size();) {
+            record r;
+            r.time  = m_file.read<double>(pos);
+            r.uid   = m_file.read<uint32_t>(pos + 8);
+            r.nnbrs = m_file.read<uint32_t>(pos + 12);
+            r.props = m_file.read<uint64_t>(pos + 16);
+            r.nbrs  = m_file.data() + pos + head;
+            pos += head + r.nnbrs * sizeof(uint32_t);
+            if (pos > m_file.size()) break;
+            f(r);
+        }
+    }
+
+  private:
+    //! @brief The trace file.
+    mapped_file m_file;
+
+    //! @brief The number of propositions.
+    uint32_t m_nprops;
+};
+
+//! @brief Checks the trace bits of the propositions of a monitor, throwing if they do not fit in a bitmask of rounds.
+inline std::vector<size_t> checked_bits(std::vector<size_t> bits) {
+    if (bits.size() > max_props) throw std::invalid_argument("too many propositions for a monitor");
+    for (size_t b : bits)
+        if (b >= max_props) throw std::invalid_argument("proposition bit " + std::to_string(b) + " out of range (less than " + std::to_string(max_props) + " expected)");
+    return bits;
+}
+
+//! @brief Interface of a monitor replayed on a trace.
+struct replay_base {
+    //! @brief Virtual destructor.
+    virtual ~replay_base() = default;
+    //! @brief Evaluates the monitor in a recorded round, returning its value.
+    virtual bool step(reader::record const& r) = 0;
+    //! @brief Bytes of the state exchanged with neighbours in every round.
+    virtual size_t state_bytes() const = 0;
+};
+
+/**
+ * @brief Monitor of a fused formula F, replayed on a trace.
+ *
+ * Every node keeps the last state of the formula, which is given to neighbours as in the `nbr`
+ * of a fused monitor. The i-th proposition of the formula is read from the bit `bits[i]` of the trace.
+ */
+template <typename F>
+class replay_monitor : public replay_base {
+    //! @brief The state type of the formula.
+    using state_type = coordination::formula::state_t<F>;
+
+  public:
+    //! @brief Constructor, given the trace bits of the formula propositions (throws if not less than `max_props`).
+    replay_monitor(std::vector<size_t> bits) : m_bits(checked_bits(std::move(bits))) {}
+
+    //! @brief Evaluates the monitor in a recorded round, returning its value.
+    bool step(reader::record const& r) override {
+        std::array<bool, max_props> props{};
+        for (size_t i = 0; i < m_bits.size(); ++i)
+            props[i] = (r.props >> m_bits[i]) & 1;
+        auto it = m_state.find(r.uid);
+        state_type prev = it == m_state.end() ? coordination::formula::initial_state<F>() : it->second;
+        state_type all = prev, any = prev;
+        for (size_t i = 0; i < r.nnbrs; ++i) {
+            uint32_t n = r.nbr(i);
+            if (n == r.uid) continue;
+            auto jt = m_state.find(n);
+            if (jt == m_state.end()) continue;
+            all &= jt->second;
+            any |= jt->second;
+        }
+        state_type next = prev;
+        bool v = coordination::formula::evaluate<F>(props, prev, all, any, next);
+        m_state[r.uid] = next;
+        return v;
+    }
+
+    //! @brief Bytes of the state exchanged with neighbours in every round.
+    size_t state_bytes() const override {
+        return sizeof(state_type);
+    }
+
+  private:
+    //! @brief Trace bits of the formula propositions.
+    std::vector<size_t> m_bits;
+
+    //! @brief Last state of every node.
+    std::unordered_map<uint32_t, state_type> m_state;
+};
+
+/**
+ * @brief Centralized reference checker of a fused formula F, replayed on a trace.
+ *
+ * Evaluates F as if every node received the last state of every other node in every round, regardless
+ * of the recorded neighbourhoods, giving the ideal value of the formula for an observer of the whole
+ * system. Since the conjunction and disjunction of all states are taken from counts of nodes with each
+ * state bit set, a round costs time linear in the state bits and not in the number of nodes.
+ */
+template <typename F>
+class reference_monitor : public replay_base {
+    //! @brief The state type of the formula.
+    using state_type = coordination::formula::state_t<F>;
+
+  public:
+    //! @brief Constructor, given the trace bits of the formula propositions (throws if not less than `max_props`).
+    reference_monitor(std::vector<size_t> bits) : m_bits(checked_bits(std::move(bits))) {}
+
+    //! @brief Evaluates the monitor in a recorded round, returning its value.
+    bool step(reader::record const& r) override {
+        std::array<bool, max_props> props{};
+        for (size_t i = 0; i < m_bits.size(); ++i)
+            props[i] = (r.props >> m_bits[i]) & 1;
+        auto it = m_state.find(r.uid);
+        bool known = it != m_state.end();
+        state_type prev = known ? it->second : coordination::formula::initial_state<F>();
+        // other nodes with every state bit set
+        size_t others = m_state.size() - known;
+        state_type all = prev, any = prev;
+        for (size_t b = 0; b < state_type::size(); ++b) {
+            size_t set = m_count[b] - (known and prev[b]);
+            all.set(b, prev[b] and set == others);
+            any.set(b, prev[b] or set > 0);
+        }
+        state_type next = prev;
+        bool v = coordination::formula::evaluate<F>(props, prev, all, any, next);
+        for (size_t b = 0; b < state_type::size(); ++b)
+            m_count[b] += size_t(next[b]) - size_t(known and prev[b]);
+        m_state[r.uid] = next;
+        return v;
+    }
+
+    //! @brief Bytes of the state exchanged with neighbours in every round.
+    size_t state_bytes() const override {
+        return sizeof(state_type);
+    }
+
+  private:
+    //! @brief Trace bits of the formula propositions.
+    std::vector<size_t> m_bits;
+
+    //! @brief Last state of every node.
+    std::unordered_map<uint32_t, state_type> m_state;
+
+    //! @brief Number of nodes with every state bit set.
+    std::array<size_t, state_type::size()> m_count{};
+};
+
+}
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+//! @brief Records the atomic propositions of the current round (if a trace is being recorded).
+FUN void record_propositions(ARGS, uint64_t props) { CODE
+    proposition_trace::recorder& r = proposition_trace::recorder::instance();
+    if (not r.active()) return;
+    std::vector<uint32_t> nbrs;
+    for (device_t id : fcpp::details::get_ids(node.nbr_uid()))
+        nbrs.push_back(id);
+    r.record(node.current_time(), node.uid, props, nbrs);
+}
+
+}
+
+}
+
+#endif // FCPP_PROPOSITION_TRACE_H_
@@ -0,0 +1,84 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file quiescent_logic.hpp
+ * @brief Past-CTL operators AH and EP which stop computing and exporting once settled.
+ *
+ * The value of `AH` can only switch from true to false, and the value of `EP` from false to true.
+ * Once a device reached that final value, its argument is no longer evaluated (so that its whole
+ * subtree stops contributing to exports). Once also all its neighbours reached it, the device goes
+ * quiet and exports its value only once every `period` rounds: this is enough for devices joining
+ * the neighbourhood afterwards to receive the final value, and to wake up the device if they need it.
+ */
+
+#ifndef FCPP_QUIESCENT_LOGIC_H_
+#define FCPP_QUIESCENT_LOGIC_H_
+
+#include "lib/beautify.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+//! @brief Default number of rounds between the exports of a quiet device.
+constexpr int quiescence_period = 16;
+
+//! @brief The types used in export by quiescent operators.
+FUN_EXPORT quiescent_logic_t = common::export_list<bool, int>;
+
+//! @cond INTERNAL
+namespace details {
+    /**
+     * @brief Monotone operator with final value `absorbing`, with argument computed by g.
+     *
+     * The state of the device is -1 while the value is not final, 0 while the value is final but some
+     * neighbour may not know it, and the number of rounds since it went quiet otherwise.
+     */
+    template <bool absorbing, typename node_t, typename G>
+    bool quiescent(ARGS, G&& g, int period) { CODE
+        int phase = old(CALL, -1, [&](int phase){
+            if (phase > 0 and phase % period != 0) return phase + 1;
+            bool settled = true;
+            bool v = nbr(CALL, not absorbing, [&](field<bool> o){
+                // whether every neighbour (besides the device itself) had the final value
+                settled = absorbing ? fold_hood(CALL, [](bool x, bool y){
+                    return x and y;
+                }, o, true) : not fold_hood(CALL, [](bool x, bool y){
+                    return x or y;
+                }, o, false);
+                if (phase >= 0) return absorbing;
+                bool r = fold_hood(CALL, [](bool x, bool y){
+                    return absorbing ? x or y : x and y;
+                }, o);
+                return absorbing ? bool(g()) or r : bool(g()) and r;
+            });
+            if (v != absorbing) return -1;
+            return settled ? std::max(phase, 0) + 1 : 0;
+        });
+        return phase >= 0 ? absorbing : not absorbing;
+    }
+}
+//! @endcond
+
+//! @brief Value g() has been true in every causal past event (stopping once settled).
+template <typename node_t, typename G>
+bool quiescent_AH(ARGS, G&& g, int period = quiescence_period) { CODE
+    return details::quiescent<false>(CALL, g, period);
+}
+
+//! @brief Value g() has been true in some causal past event (stopping once settled).
+template <typename node_t, typename G>
+bool quiescent_EP(ARGS, G&& g, int period = quiescence_period) { CODE
+    return details::quiescent<true>(CALL, g, period);
+}
+
+}
+
+}
+
+#endif // FCPP_QUIESCENT_LOGIC_H_
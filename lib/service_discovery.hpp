@@ -9,7 +9,15 @@
 #define FCPP_SERVICE_DISCOVERY_H_
 
 #include "lib/fcpp.hpp"
+#include "lib/profiler.hpp"
+#include "lib/batch_runner.hpp"
+#include "lib/export_cost.hpp"
+#include "lib/failure_stats.hpp"
+#include "lib/proposition_trace.hpp"
+#include "lib/sweep.hpp"
 #include "lib/logic_samples.hpp"
+#include "lib/monitor_flags.hpp"
+#include "lib/violation_provenance.hpp"
 
 
 /**
@@ -31,13 +39,18 @@ namespace tags {
     //! @brief Parametric tag for formula failure.
     template <typename T>
     struct fail {};
-    //! @brief Response time monitor formula for message type i.
-    template <int i>
-    struct timeout_monitor {};
     //! @brief Unwanted response monitor formula.
     struct spurious_monitor {};
     //! @brief No double requests monitor formula.
     struct double_req_monitor {};
+    //! @brief Response time monitor formula (one flag per message type).
+    struct timeouts_monitor {};
+    //! @brief Local unwanted response formula.
+    struct local_spurious_monitor {};
+    //! @brief Local double request formula.
+    struct local_double_req_monitor {};
+    //! @brief Local response delay formula.
+    struct local_timeout_monitor {};
     //! @brief Whether the node is edge, fog or cloud.
     struct node_type {};
     //! @brief Color representing the status a node (compute, wait response by type).
@@ -48,6 +61,9 @@ namespace tags {
     struct size {};
 }
 
+//! @brief Namespace of the service discovery case study.
+inline namespace service_discovery {
+
 //! @brief Number of time instants before waiting response T/O
 constexpr size_t resp_timeout = 5;
 
@@ -66,6 +82,37 @@ constexpr real_t random_resp[] = {0.3, 0.45, 0.6, 0.75};
 //! @brief Number of request types.
 constexpr size_t ntypes_req = 4;
 
+//! @brief Parameters of the case study which can be changed at runtime (defaulting to the constants above).
+struct parameters {
+    //! @brief Number of time instants before waiting response T/O
+    size_t resp_timeout = coordination::resp_timeout;
+    //! @brief Probability of issuing a request while computing.
+    real_t random_req = coordination::random_req;
+    //! @brief Probability of sending a spurious second-in-a-row request
+    real_t random_err_req = coordination::random_err_req;
+    //! @brief Probability of receiving a response not matching the previous request
+    real_t random_err_resp = coordination::random_err_resp;
+    //! @brief Probability of receiving a response while waiting (by req type)
+    std::array<real_t, ntypes_req> random_resp = {coordination::random_resp[0], coordination::random_resp[1], coordination::random_resp[2], coordination::random_resp[3]};
+
+    //! @brief Sets a parameter by name (`random_resp1` to `random_resp4` for types), returning whether it exists.
+    bool set(std::string const& name, double value) {
+        if (name == "resp_timeout") resp_timeout = value;
+        else if (name == "random_req") random_req = value;
+        else if (name == "random_err_req") random_err_req = value;
+        else if (name == "random_err_resp") random_err_resp = value;
+        else if (name.size() == 12 and name.substr(0, 11) == "random_resp" and name[11] >= '1' and name[11] < char('1' + ntypes_req))
+            random_resp[name[11] - '1'] = value;
+        else return false;
+        return true;
+    }
+};
+
+//! @brief The parameters used by the current thread.
+inline parameters& params() {
+    return sweep::current<parameters>();
+}
+
 //! @brief Status of devices.
 enum class status {
     COMPUTE,   // computing
@@ -75,28 +122,14 @@ enum class status {
 //! @brief Colors to represent request type and status.
 packed_color status_colors[] = {SILVER, YELLOW, LIME_GREEN, RED, FUCHSIA};
 
-//! @brief Helper function to access storage.
-template <template<int> class T, typename node_t>
-bool& storage(node_t& node, size_t i) {
-    using namespace tags;
-    switch (i) {
-    case 1:
-        return node.storage(fail<T<1>>{});
-    case 2:
-        return node.storage(fail<T<2>>{});
-    case 3:
-        return node.storage(fail<T<3>>{});
-    default:
-        assert(i == 4);
-        return node.storage(fail<T<4>>{});
-    }
-}
-
 //! @brief Service discovery case study.
 MAIN() {
     using namespace tags;
     using namespace component::tags;
 
+    PROFILE_SCOPE("main");
+    count_round(CALL);
+
     if (node.storage(node_type{}) == devtype::EDGE) {
         // set random time to enter (between 0 and 20)
         times_t start_time = constant(CALL, node.next_real(0, 20));
@@ -105,10 +138,10 @@ MAIN() {
             return;
         } else node.storage(size{}) = 15;
 
-        // set random time to exit (between 100 and 150)
+        // set random time to exit (between 100 and 150), terminating so that the device stops sending exports
         times_t exit_time = constant(CALL, node.next_real(100, 150));
         if (node.current_time() > exit_time) {
-            node.storage(size{}) = 0;
+            node.terminate();
             return;
         }
     }
@@ -123,45 +156,66 @@ MAIN() {
         size_t req_type = get<1>(o);
 
         if (stat == status::COMPUTE) {
-            if (node.next_real() < random_req) {
+            if (node.next_real() < params().random_req) {
                 stat = status::WAITRESP;
                 req_type = node.next_real(1, ntypes_req+1);
                 req = true;
             }
         } else if (stat == status::WAITRESP) {
             // the response probability depends on the type of request
-            if (node.next_real() < random_resp[req_type-1]) {
+            if (node.next_real() < params().random_resp[req_type-1]) {
                 resp_type = req_type;
                 stat = status::COMPUTE;
                 req_type = 0;
                 resp = true;
-            } else if (node.next_real() < random_err_resp) {
+            } else if (node.next_real() < params().random_err_resp) {
                 resp_type = 1 + req_type % ntypes_req;
                 resp = true;
-            } else if (node.next_real() < random_err_req)
+            } else if (node.next_real() < params().random_err_req)
                 req = true;
         }
 
         return make_tuple(stat, req_type);
     });
 
-    bool no_unwanted_response = true;
-    bool no_double_request = true;
-    bool local_unwanted = false;
-    bool local_duplicated = false;
-    bool local_delay = false;
-    for (LOOP(i, 0); i<ntypes_req; ++i) {
-        bool rq = req && (req_type == i+1);
-        bool rs = resp && (resp_type == i+1);
-        storage<timeout_monitor>(node, i+1) = !logic::all_response_time(CALL, rq, rs, resp_timeout);
-        no_unwanted_response &= logic::no_unwanted_response(CALL, rq, rs);
-        no_double_request &= logic::no_double_request(CALL, rq, rs);
-        local_unwanted |= logic::my_unwanted_response(CALL, rq, rs);
-        local_duplicated |= logic::my_double_request(CALL, rq, rs);
-        local_delay |= logic::no_reply(CALL, rq, rs, resp_timeout);
+    packed_bits<ntypes_req> rq, rs;
+    for (size_t i=0; i<ntypes_req; ++i) {
+        rq.set(i, req && (req_type == i+1));
+        rs.set(i, resp && (resp_type == i+1));
     }
-    node.storage(fail<spurious_monitor>{}) = !no_unwanted_response;
-    node.storage(fail<double_req_monitor>{}) = !no_double_request;
+    uint64_t trace_props = 0;
+    for (size_t i=0; i<ntypes_req; ++i)
+        trace_props |= uint64_t(rq[i]) << (2*i) | uint64_t(rs[i]) << (2*i+1);
+    record_propositions(CALL, trace_props);
+    using packed_t = packed_bits<ntypes_req>;
+    packed_t response_time = export_cost<timeouts_monitor, payload<std::array<int, ntypes_req>, packed_t>>(CALL, [&](){
+        return logic::all_response_time(CALL, rq, rs, params().resp_timeout);
+    });
+    monitor_flags& timeout_fail = node.storage(fail<timeouts_monitor>{});
+    timeout_fail.resize(ntypes_req);
+    for (size_t i=0; i<ntypes_req; ++i)
+        timeout_fail.set(i, !response_time[i]);
+    node.storage(fail<spurious_monitor>{}) = export_cost<spurious_monitor, formula_payload<logic::fused::no_unwanted_response, packed_t>>(CALL, [&](){
+        return !logic::no_unwanted_response(CALL, rq, rs).all();
+    });
+    node.storage(fail<double_req_monitor>{}) = export_cost<double_req_monitor, formula_payload<logic::fused::no_double_request, packed_t>>(CALL, [&](){
+        return !logic::no_double_request(CALL, rq, rs).all();
+    });
+    bool local_unwanted = export_cost<local_spurious_monitor, formula_payload<logic::fused::my_unwanted_response, packed_t>>(CALL, [&](){
+        return logic::my_unwanted_response(CALL, rq, rs).any();
+    });
+    bool local_duplicated = export_cost<local_double_req_monitor, formula_payload<logic::fused::my_double_request, packed_t>>(CALL, [&](){
+        return logic::my_double_request(CALL, rq, rs).any();
+    });
+    bool local_delay = export_cost<local_timeout_monitor>(CALL, params().resp_timeout * entry_size<packed_t>(), [&](){
+        return logic::no_reply(CALL, rq, rs, params().resp_timeout).any();
+    });
+    track_failure<spurious_monitor>(CALL, node.storage(fail<spurious_monitor>{}));
+    track_failure<double_req_monitor>(CALL, node.storage(fail<double_req_monitor>{}));
+    record_provenance(CALL, trace_props, uint64_t(node.storage(fail<spurious_monitor>{})) | uint64_t(node.storage(fail<double_req_monitor>{})) << 1
+        | uint64_t(local_unwanted) << 2 | uint64_t(local_duplicated) << 3 | uint64_t(local_delay) << 4);
+    watch_violation(CALL, 0, "spurious_monitor", node.storage(fail<spurious_monitor>{}), local_unwanted);
+    watch_violation(CALL, 1, "double_req_monitor", node.storage(fail<double_req_monitor>{}), local_duplicated);
     double waiting_time = req_type > 0 ? 1.0/counter(CALL) : 1;
     node.storage(status_c{}) = color(status_colors[req_type]);
     node.storage(waiting_c{}) = waiting_time * node.storage(status_c{}) + (1-waiting_time) * color(BLACK);
@@ -174,7 +228,159 @@ MAIN() {
     else
         node.storage(shape{}) = shape::sphere;
 }
-FUN_EXPORT main_t = common::export_list<real_t, tuple<status, size_t>, logic_t, counter_t<>>;
+FUN_EXPORT main_t = common::export_list<real_t, tuple<status, size_t>, packed_samples_t<ntypes_req>, counter_t<>, provenance_t, export_cost_t>;
+
+}
+
+}
+
+//! @brief Namespace for all the simulation options.
+namespace option {
+
+//! @brief Simulation options of the service discovery case study.
+inline namespace service_discovery {
+
+using namespace component::tags;
+using namespace coordination::tags;
+
+//! @brief Number of atomic propositions recorded in traces (request and response for each type).
+constexpr uint32_t trace_props = 8;
+
+//! @brief Number of edge nodes
+constexpr size_t edge_num = 50;
+
+//! @brief Number of fog nodes
+constexpr size_t fog_num = 20;
+
+//! @brief Number of cloud nodes
+constexpr size_t cloud_num = 5;
+
+//! @brief Dimensionality of the space.
+constexpr size_t dim = 3;
+
+//! @brief Final time for the plots.
+constexpr size_t end_time = 150;
+
+
+//! @brief Description of the round schedule.
+using round_s = sequence::periodic<
+    distribution::interval_n<times_t, 0, 1>,
+    distribution::weibull_n<times_t, 10, 1, 10>,
+    distribution::constant_n<times_t, 2*end_time>
+>;
+
+//! @brief Description of the export schedule.
+using export_s = sequence::periodic_n<1, 0, 1, end_time>;
+
+//! @brief Description of the sequences of node creation events.
+//! @{
+using edge_spawn_s  = sequence::multiple_n<edge_num,  0>;
+using fog_spawn_s   = sequence::multiple_n<fog_num,   0>;
+using cloud_spawn_s = sequence::multiple_n<cloud_num, 0>;
+//! @}
+
+//! @brief Description of the initial position distributions.
+//! @{
+using edge_circle_d  = sequence::circle_n<1, 500, 500, 0, 0, 0, 300, edge_num>;
+using fog_circle_d   = sequence::circle_n<1, 500, 500, 0, 0, 0, 200, fog_num>;
+using cloud_circle_d = sequence::circle_n<1, 500, 500, 0, 0, 0, 50,  cloud_num>;
+//! @}
+
+//! @brief Description of the node type distributions.
+//! @{
+CONSTANT_DISTRIBUTION(edge_d,  devtype, devtype::EDGE);
+CONSTANT_DISTRIBUTION(fog_d,   devtype, devtype::FOG);
+CONSTANT_DISTRIBUTION(cloud_d, devtype, devtype::CLOUD);
+//! @}
+
+//! @brief Description of the node shape distribution.
+CONSTANT_DISTRIBUTION(shape_d, shape, shape::sphere);
+
+//! @brief Storage tags and types.
+using storage_t = tuple_store<
+    fail<timeouts_monitor>,        monitor_flags,
+    fail<spurious_monitor>,        bool,
+    fail<double_req_monitor>,      bool,
+    node_type,                     devtype,
+    status_c,                      color,
+    waiting_c,                     color,
+    shape,                         shape,
+    size,                          double,
+    round_count,                   size_t
+>;
+
+//! @brief Storage tags to be logged with aggregators (over the devices still in the network).
+using aggregator_t = aggregators<
+    fail<timeouts_monitor>,        aggregator::flags,
+    fail<spurious_monitor>,        aggregator::mean<double>,
+    fail<double_req_monitor>,      aggregator::mean<double>
+>;
+
+//! @brief Calls whose export size is statically estimated.
+//! @{
+using cost_storage_t = coordination::export_cost_store<timeouts_monitor, spurious_monitor, double_req_monitor, local_spurious_monitor, local_double_req_monitor, local_timeout_monitor>;
+using cost_aggregator_t = coordination::export_cost_aggregators<timeouts_monitor, spurious_monitor, double_req_monitor, local_spurious_monitor, local_double_req_monitor, local_timeout_monitor>;
+//! @}
+
+//! @brief Monitors whose failure statistics are logged.
+//! @{
+using stats_storage_t = coordination::failure_stats_store<spurious_monitor, double_req_monitor>;
+using stats_aggregator_t = coordination::failure_stats_aggregators<spurious_monitor, double_req_monitor>;
+//! @}
+
+//! @brief Plot description.
+using plotter_t = coordination::failure_stats_plotter<coordination::export_cost_plotter<plot::plotter<aggregator_t, plot::time, fail>, cost_aggregator_t>, stats_aggregator_t>;
+
+//! @brief Options list (with a given plotter type, the plot description by default).
+template <bool parallel_flag, typename plot_t = plotter_t>
+DECLARE_OPTIONS(list,
+    parallel<parallel_flag>,
+    synchronised<false>,
+    dimension<dim>,
+    program<coordination::main>,
+    exports<coordination::main_t>,
+    retain<metric::retain<2,1>>,
+    connector<connect::hierarchical<connect::powered<200, 1, 3>>>,
+    round_schedule<round_s>,
+    log_schedule<export_s>,
+    spawn_schedule<edge_spawn_s>,
+    init<
+	shape, shape_d,
+	x, edge_circle_d,  node_type, edge_d,
+	size, distribution::constant_n<double, 0>,
+	network_rank, distribution::constant_n<int, 2>,
+	send_power_ratio, distribution::constant_n<double, 8, 10>,
+	recv_power_ratio, distribution::constant_n<double, 1>>,
+    spawn_schedule<fog_spawn_s>,
+    init<
+	shape, shape_d,
+	x, fog_circle_d, node_type, fog_d,
+	size, distribution::constant_n<double, 20>,
+	network_rank, distribution::constant_n<int, 1>,
+	send_power_ratio, distribution::constant_n<double, 1>,
+	recv_power_ratio, distribution::constant_n<double, 1>>,
+    spawn_schedule<cloud_spawn_s>,
+    init<
+	shape, shape_d,
+	x, cloud_circle_d, node_type, cloud_d,
+	size, distribution::constant_n<double, 30>,
+	network_rank, distribution::constant_n<int, 0>,
+	send_power_ratio, distribution::constant_n<double, 1>,
+	recv_power_ratio, distribution::constant_n<double, 1>>,
+    storage_t,
+    coordination::provenance_store,
+    aggregator_t,
+    cost_storage_t,
+    cost_aggregator_t,
+    stats_storage_t,
+    stats_aggregator_t,
+    plot_type<plot_t>,
+    size_tag<size>,
+    color_tag<status_c, waiting_c>,
+    shape_tag<shape>
+);
+
+}
 
 }
 
@@ -8,10 +8,15 @@
 #ifndef FCPP_SMART_GRID_H_
 #define FCPP_SMART_GRID_H_
 
-#include <stdlib.h>
-#include <time.h>
 #include "lib/fcpp.hpp"
+#include "lib/profiler.hpp"
+#include "lib/batch_runner.hpp"
+#include "lib/export_cost.hpp"
+#include "lib/failure_stats.hpp"
+#include "lib/proposition_trace.hpp"
+#include "lib/sweep.hpp"
 #include "lib/logic_samples.hpp"
+#include "lib/adaptive_schedule.hpp"
 
 // SIMULATION PARAMETER - EDIT TO UPDATE SCENARIO
 
@@ -28,6 +33,10 @@ constexpr int REPAIR_CHANCE	= 40;
 constexpr int UPDATE_TIME	= 100;
 // Maximum distance for communication between nodes (default: 75)
 constexpr int COMM_RANGE	= 75;
+// Maximum slowdown of rounds for nodes whose state is stable, 1 to disable
+// (default: 8, so that rounds are still more frequent than the 1s after
+// which neighbours are forgotten)
+constexpr int MAX_SLOWDOWN	= 8;
 
 
 /**
@@ -46,6 +55,10 @@ namespace tags {
     struct device_up_monitor {};
     struct global_up_monitor {};
     struct device_biconnection_monitor {};
+    //! @brief Hop count from the source node.
+    struct source_hops {};
+    //! @brief Hop count from the user node.
+    struct user_hops {};
     //! @brief Color representing the status a node (online, connected, offline).
     struct status_c {};
     //! @brief Color representing the property of a node (to be used for
@@ -56,11 +69,40 @@ namespace tags {
     struct curr_status {};
     //! @brief Size of the current node.
     struct size {};
+    //! @brief Time between the start of the epoch of the last failure or repair of the current node and its first round in the epoch.
+    struct epoch_lag {};
 }
 
+//! @brief Namespace of the smart grid case study.
+inline namespace smart_grid {
+
 //! @brief Status of devices.
 enum sim_status { UP, CONNECT, DOWN };
 
+//! @brief Parameters of the case study which can be changed at runtime (defaulting to the constants above).
+struct parameters {
+    //! @brief Probability of failure for the intermediate nodes (percentage).
+    int fail_chance = FAIL_CHANCE;
+    //! @brief Probability of repairment for the intermediate nodes (percentage).
+    int repair_chance = REPAIR_CHANCE;
+    //! @brief Maximum slowdown of rounds for nodes whose state is stable.
+    double max_slowdown = MAX_SLOWDOWN;
+
+    //! @brief Sets a parameter by name, returning whether it exists.
+    bool set(std::string const& name, double value) {
+        if (name == "fail_chance") fail_chance = value;
+        else if (name == "repair_chance") repair_chance = value;
+        else if (name == "max_slowdown") max_slowdown = value;
+        else return false;
+        return true;
+    }
+};
+
+//! @brief The parameters used by the current thread.
+inline parameters& params() {
+    return sweep::current<parameters>();
+}
+
 //! @brief Colors to represent node status.
 // Green nodes are online.
 // Blue nodes are online and connected to the source and user node.
@@ -87,6 +129,9 @@ MAIN() {
     using namespace tags;
     using namespace component::tags;
 
+    PROFILE_SCOPE("main");
+    count_round(CALL);
+
     // Node initialization
     if (counter(CALL) == 1) {
 	    node.storage(size{}) = 15;
@@ -94,24 +139,31 @@ MAIN() {
 	    node.storage(property_c{}) = color(GRAY);
 	    node.storage(shape{}) = shape::cube;
 	    node.storage(curr_status{}) = sim_status::UP;
-	    srand(time(NULL));
+	    node.storage(epoch_lag{}) = std::numeric_limits<real_t>::quiet_NaN();
 	    return;
     }
 
     // Update intermediate node
     if (node.uid != SOURCE && node.uid != USER) {
 	    int toggle_chance = 100;
-	    if (counter(CALL) % UPDATE_TIME == 0) {
-		    toggle_chance = rand() % 100;
-		    if(node.storage(curr_status{}) == sim_status::UP && toggle_chance < FAIL_CHANCE) {
+	    // state changes are timed, so that they do not depend on the frequency of rounds
+	    int epoch = node.current_time() * 10 / UPDATE_TIME;
+	    if (epoch != old(CALL, epoch)) {
+		    bool was_down = node.storage(curr_status{}) == sim_status::DOWN;
+		    // per-node random stream, reproducible and thread-safe
+		    toggle_chance = node.next_int(0, 99);
+		    if(node.storage(curr_status{}) == sim_status::UP && toggle_chance < params().fail_chance) {
 			    node.storage(curr_status{}) = sim_status::DOWN;
-		    } else if(node.storage(curr_status{}) == sim_status::CONNECT && toggle_chance < FAIL_CHANCE) {
+		    } else if(node.storage(curr_status{}) == sim_status::CONNECT && toggle_chance < params().fail_chance) {
 			    node.storage(curr_status{}) = sim_status::DOWN;
-		    } else if(node.storage(curr_status{}) == sim_status::DOWN && toggle_chance < REPAIR_CHANCE) {
+		    } else if(node.storage(curr_status{}) == sim_status::DOWN && toggle_chance < params().repair_chance) {
 			    node.storage(curr_status{}) = sim_status::UP;
 		    }
 		    sim_status current_state = node.storage(curr_status{});
 		    node.storage(status_c{}) = color(status_colors[current_state]);
+		    // failures and repairs happen at the start of the epoch, and the node applies them now
+		    if (was_down != (current_state == sim_status::DOWN))
+			    node.storage(epoch_lag{}) = node.current_time() - epoch * UPDATE_TIME / 10.0;
 	    }
     }
 
@@ -122,14 +174,22 @@ MAIN() {
     int from_user   = 50*50;
     if (node.storage(curr_status{}) == sim_status::UP ||
 	node.storage(curr_status{}) == sim_status::CONNECT) {
-	    from_source = abf_hops(CALL, node.uid == SOURCE);
-	    from_user   = abf_hops(CALL, node.uid == USER);
+	    from_source = export_cost<source_hops, payload<int>>(CALL, [&](){
+		    return abf_hops(CALL, node.uid == SOURCE);
+	    });
+	    from_user   = export_cost<user_hops, payload<int>>(CALL, [&](){
+		    return abf_hops(CALL, node.uid == USER);
+	    });
     }
     source_conn = from_source < 50;
     user_conn = from_user < 50;
+    record_propositions(CALL, uint64_t(device_up) | uint64_t(user_conn) << 1 | uint64_t(source_conn) << 2);
     node.storage(flag<device_up_monitor>{}) = always_up(CALL, device_up);
     node.storage(flag<global_up_monitor>{}) = nearby_up(CALL, device_up);
     node.storage(flag<device_biconnection_monitor>{}) = always_connected(CALL, user_conn, source_conn);
+    adaptive_rounds(CALL, uint64_t(node.storage(curr_status{})) | uint64_t(user_conn) << 2 | uint64_t(source_conn) << 3
+        | uint64_t(node.storage(flag<device_up_monitor>{})) << 4 | uint64_t(node.storage(flag<global_up_monitor>{})) << 5
+        | uint64_t(node.storage(flag<device_biconnection_monitor>{})) << 6, params().max_slowdown);
     if (node.uid == SOURCE) {
         node.storage(shape{}) = shape::star;
 	node.storage(curr_status{}) = sim_status::UP;
@@ -160,7 +220,123 @@ FUN_EXPORT main_t = common::export_list<
 	tuple<status, size_t>,
 	logic_t,
 	counter_t<>,
-	abf_hops_t>;
+	int,
+	abf_hops_t,
+	adaptive_rounds_t,
+	export_cost_t>;
+}
+
+}
+
+//! @brief Namespace for all the simulation options.
+namespace option {
+
+//! @brief Simulation options of the smart grid case study.
+inline namespace smart_grid {
+
+using namespace component::tags;
+using namespace coordination::tags;
+
+//! @brief Number of atomic propositions recorded in traces (device up, user and source connected).
+constexpr uint32_t trace_props = 3;
+
+//! @brief Number of node nodes
+constexpr size_t node_num = 100;
+
+//! @brief Dimensionality of the space.
+constexpr size_t dim = 2;
+
+//! @brief Final time for the plots.
+constexpr size_t end_time = 150;
+
+
+//! @brief Description of the round schedule.
+using round_s = sequence::periodic<
+    distribution::interval_n<times_t, 0, 1>,
+    distribution::weibull_n<times_t, 10, 1, 100>,
+    distribution::constant_n<times_t, end_time+10>
+>;
+
+//! @brief Description of the export schedule.
+using export_s = sequence::periodic_n<1, 0, 1, end_time>;
+
+//! @brief Description of the sequences of node creation events.
+//! @{
+using node_spawn_s  = sequence::multiple_n<node_num,  0>;
+//! @}
+
+//! @brief Description of the initial position distributions.
+//! @{
+using node_grid_d  = sequence::grid_n<1, 0, 0, 500, 500, 10, 10>;
+//! @}
+
+//! @brief Description of the node shape distribution.
+CONSTANT_DISTRIBUTION(shape_d, shape, shape::sphere);
+
+//! @brief Storage tags and types.
+using storage_t = tuple_store<
+    flag<device_up_monitor>,  bool,
+    flag<global_up_monitor>,   bool,
+    flag<device_biconnection_monitor>,   bool,
+    status_c,                      color,
+    property_c,                    color,
+    shape,                         shape,
+    size,                          double,
+    curr_status,		   fcpp::coordination::sim_status,
+    round_count,                   size_t,
+    round_slowdown,                real_t,
+    epoch_lag,                     real_t
+>;
+
+//! @brief Storage tags to be logged with aggregators.
+using aggregator_t = aggregators<
+    flag<device_up_monitor>,  aggregator::count<double>,
+    flag<global_up_monitor>,   aggregator::count<double>,
+    flag<device_biconnection_monitor>,   aggregator::count<double>,
+    round_slowdown,                aggregator::combine<aggregator::mean<double>, aggregator::max<double>>,
+    epoch_lag,                     aggregator::sketch<real_t, 50, 95, 99>
+>;
+
+//! @brief Calls whose export size is statically estimated.
+//! @{
+using cost_storage_t = coordination::export_cost_store<source_hops, user_hops>;
+using cost_aggregator_t = coordination::export_cost_aggregators<source_hops, user_hops>;
+//! @}
+
+//! @brief Plot description.
+using plotter_t = coordination::export_cost_plotter<plot::plotter<aggregator_t, plot::time, flag>, cost_aggregator_t>;
+
+//! @brief Options list (with a given plotter type, the plot description by default).
+template <bool parallel_flag, typename plot_t = plotter_t>
+DECLARE_OPTIONS(list,
+    parallel<parallel_flag>,
+    synchronised<false>,
+    dimension<dim>,
+    program<coordination::main>,
+    exports<coordination::main_t>,
+    retain<metric::retain<1,1>>,
+    connector<connect::fixed<COMM_RANGE, 1, dim>>,
+    round_schedule<round_s>,
+    log_schedule<export_s>,
+    spawn_schedule<node_spawn_s>,
+    init<
+	shape, shape_d, x, node_grid_d,
+	size, distribution::constant_n<double, 0>,
+	network_rank, distribution::constant_n<int, 2>,
+	send_power_ratio, distribution::constant_n<double, 8, 10>,
+	recv_power_ratio, distribution::constant_n<double, 1>>,
+    storage_t,
+    aggregator_t,
+    cost_storage_t,
+    cost_aggregator_t,
+    plot_type<plot_t>,
+    size_tag<size>,
+    color_tag<status_c, property_c>,
+    shape_tag<shape>
+);
+
+}
+
 }
 
 }
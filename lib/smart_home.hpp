@@ -9,6 +9,11 @@
 #define FCPP_SMART_HOME_H_
 
 #include "lib/fcpp.hpp"
+#include "lib/profiler.hpp"
+#include "lib/batch_runner.hpp"
+#include "lib/export_cost.hpp"
+#include "lib/proposition_trace.hpp"
+#include "lib/sweep.hpp"
 #include "lib/logic_samples.hpp"
 
 
@@ -36,67 +41,186 @@ namespace tags {
     struct col {};
     //! @brief Size of the current node (strong monitor true < globally false < locally false).
     struct size {};
+    //! @brief Number of people in range of the current node.
+    struct occupants {};
+}
+
+//! @brief Namespace of the smart home case study.
+inline namespace smart_home {
+
+//! @brief Parameters of the building which can be changed at runtime (defaulting to the demo floor).
+struct parameters {
+    //! @brief number of floors
+    size_t floors = 1;
+    //! @brief number of rooms on each side of the corridor of a floor
+    size_t columns = 4;
+    //! @brief number of lights in each room
+    size_t room_lights = 1;
+
+    //! @brief Sets a parameter by name, returning whether it exists.
+    bool set(std::string const& name, double value) {
+        if (name == "floors") floors = value;
+        else if (name == "columns") columns = value;
+        else if (name == "room_lights") room_lights = value;
+        else return false;
+        return true;
+    }
+};
+
+//! @brief The parameters used by the current thread.
+inline parameters& params() {
+    return sweep::current<parameters>();
 }
 
 /**
- * @brief The location of the door of each room (with an offset).
+ * @brief Layout of a building, generated from its parameters.
  *
- * Columns vary from 0 to 3.
- * Room rows are -1 and +1; row zero is the corridor.
- * The offset varies from -3 to +2.
+ * Every floor has a 3m wide central corridor along the x axis, with a row of 6x6m rooms on each side.
+ * Floors are 10m apart, so that devices on different floors are not connected. Lights are the first
+ * devices: on every floor, the lights of the rooms on the lower side (evenly spaced along x), those of
+ * the corridor (one per room) and those of the rooms on the upper side, 2m above the floor. Rooms are
+ * identified by floor, row (-1 and +1 for the two sides, 0 for the corridor) and column.
  */
-FUN vec<3> room_door(ARGS, int row, int column, int offset) { CODE
-    return make_vec(6*column+3, (1.5 + 0.25*offset)*row + 7.5, 0);
-}
+class building {
+  public:
+    //! @brief Side of rooms.
+    static constexpr real_t room_side = 6;
+
+    //! @brief Distance between floors.
+    static constexpr real_t floor_gap = 10;
+
+    //! @brief A room (or the corridor) of the building.
+    struct room_t {
+        //! @brief The floor.
+        int floor;
+        //! @brief The side of the corridor (0 for the corridor).
+        int row;
+        //! @brief The column (0 for the corridor).
+        int column;
+    };
+
+    //! @brief Constructor, precomputing the positions of the lights.
+    building(parameters const& p) : m_params(p) {
+        for (size_t f = 0; f < p.floors; ++f)
+            for (int row = -1; row <= 1; ++row)
+                for (size_t c = 0; c < p.columns; ++c) {
+                    size_t n = row == 0 ? 1 : p.room_lights;
+                    for (size_t i = 0; i < n; ++i)
+                        m_lights.push_back(make_vec(room_side*(c + (i + 0.5)/n), 4.5*row + 7.5, floor_gap*f + 2));
+                }
+    }
+
+    //! @brief Whether the building was generated from given parameters.
+    bool generated_by(parameters const& p) const {
+        return p.floors == m_params.floors and p.columns == m_params.columns and p.room_lights == m_params.room_lights;
+    }
+
+    //! @brief Number of floors.
+    size_t floors() const {
+        return m_params.floors;
+    }
+
+    //! @brief Number of rooms on each side of the corridor of a floor.
+    size_t columns() const {
+        return m_params.columns;
+    }
+
+    //! @brief Number of rooms.
+    size_t rooms() const {
+        return 2 * m_params.floors * m_params.columns;
+    }
+
+    //! @brief Number of lights (the devices with the lowest identifiers).
+    size_t lights() const {
+        return m_lights.size();
+    }
+
+    //! @brief Position of the light with a given identifier.
+    vec<3> const& light(device_t uid) const {
+        return m_lights[uid];
+    }
+
+    //! @brief Length of the floors (along x).
+    real_t width() const {
+        return room_side * m_params.columns;
+    }
+
+    //! @brief Depth of the floors (along y).
+    real_t depth() const {
+        return 2 * room_side + 3;
+    }
+
+    //! @brief The room of a position.
+    room_t room(vec<3> const& pos) const {
+        int floor = std::lround(pos[2] / floor_gap);
+        real_t y = pos[1] - 7.5;
+        if (-1 < y and y < 1) return {floor, 0, 0}; // corridor
+        return {floor, y > 0 ? 1 : -1, int(pos[0] / room_side)};
+    }
+
+    /**
+     * @brief The location of the door of a room (with an offset).
+     *
+     * The offset varies from -3 (in the corridor) to +2 (inside the room).
+     */
+    vec<3> door(room_t r, int offset) const {
+        return make_vec(room_side*r.column + 3, (1.5 + 0.25*offset)*r.row + 7.5, floor_gap*r.floor);
+    }
+
+  private:
+    //! @brief The parameters of the building.
+    parameters m_params;
 
-//! @brief Get the room index from the position.
-FUN tuple<int,int> get_room(ARGS, vec<3> pos) { CODE
-    pos[1] -= 7.5;
-    if (-1 < pos[1] and pos[1] < 1) return {0, 0}; // corridor
-    return {pos[1] > 0 ? 1 : -1, int(pos[0] / 6)};
+    //! @brief Positions of the lights.
+    std::vector<vec<3>> m_lights;
+};
+
+//! @brief The building generated from the parameters used by the current thread.
+inline building const& layout() {
+    thread_local building b{params()};
+    if (not b.generated_by(params())) b = building{params()};
+    return b;
 }
 
-//! @brief Generates a target in a given row and column.
-FUN vec<3> random_room_target(ARGS, int row, int column) { CODE
-    if (row == 0) {
-        column = node.next_int(0, 3);
-        row = node.next_int(0, 1);
-        if (row == 0) row = -1;
-        return room_door(CALL, row, column, -1);
+//! @brief Generates a target in a given room (a room door on the same floor, for the corridor).
+FUN vec<3> random_room_target(ARGS, building::room_t r) { CODE
+    if (r.row == 0) {
+        r.column = node.next_int(0, int(layout().columns()) - 1);
+        r.row = node.next_int(0, 1);
+        if (r.row == 0) r.row = -1;
+        return layout().door(r, -1);
     }
-    return random_rectangle_target(CALL, make_vec(6*column+1, 2.5*row+7.5, 0), make_vec(6*column+5, 6.5*row+7.5, 0));
+    real_t x = building::room_side*r.column, z = building::floor_gap*r.floor;
+    return random_rectangle_target(CALL, make_vec(x+1, 2.5*r.row+7.5, z), make_vec(x+5, 6.5*r.row+7.5, z));
 }
 
-//! @brief Random walking within a 24x3m central corridor with 8 adjacent 6x6m rooms.
+//! @brief Random walking within the floor of a building, through the rooms and the corridor.
 FUN void building_walk(ARGS, real_t max_v, real_t period) { CODE
-    if (node.uid < 12) {
-        int row = node.uid / 4;
-        int col = node.uid % 4;
-        node.position() = make_vec(6*col+3, 4.5*row+3, 2);
+    building const& b = layout();
+    if (node.uid < b.lights()) {
+        node.position() = b.light(node.uid);
         return;
-    } else if (node.uid < 14 and old(CALL, true, false)) {
-        if (node.uid == 12) node.position() = make_vec(0.9, 0.9, 0);
-        if (node.uid == 13) node.position() = make_vec(23.1, 14.1, 0);
+    } else if (node.uid < b.lights() + 2 and old(CALL, true, false)) {
+        if (node.uid == b.lights()) node.position() = make_vec(0.9, 0.9, 0);
+        else node.position() = make_vec(b.width() - 0.9, b.depth() - 0.9, 0);
     }
     old(CALL, node.position(), [&](vec<3> t){
         real_t dist = follow_target(CALL, t, max_v, period);
         if (dist < max_v * period) { // maybe change target
-            tuple<int,int> room = get_room(CALL, t);
-            int row = get<0>(room);
-            int col = get<1>(room);
-            if (row == 0)
-                t = random_room_target(CALL, row, col);
-            else if (t == room_door(CALL, row, col, +1))
-                t = room_door(CALL, row, col, -3);
-            else if (t == room_door(CALL, row, col, -1))
-                t = room_door(CALL, row, col, +2);
-            else if (t == room_door(CALL, row, col, +2))
-                t = random_room_target(CALL, row, col);
+            building::room_t r = b.room(t);
+            if (r.row == 0)
+                t = random_room_target(CALL, r);
+            else if (t == b.door(r, +1))
+                t = b.door(r, -3);
+            else if (t == b.door(r, -1))
+                t = b.door(r, +2);
+            else if (t == b.door(r, +2))
+                t = random_room_target(CALL, r);
             else if (node.next_real() < 0.05) {
                 if (node.next_real() < 0.5)
-                    t = random_room_target(CALL, row, col);
+                    t = random_room_target(CALL, r);
                 else
-                    t = room_door(CALL, row, col, +1);
+                    t = b.door(r, +1);
             }
         }
         return t;
@@ -108,20 +232,33 @@ FUN void building_walk(ARGS, real_t max_v, real_t period) { CODE
 MAIN() {
     using namespace tags;
 
+    PROFILE_SCOPE("main");
+    count_round(CALL);
     building_walk(CALL, 1.4, 1);
 
     constexpr real_t STILL_FAIL = 0.003; // prob. of failure in still situation
     constexpr real_t SWITCH_FAIL = 0.05; // prob. of failure in changing situation
-    size_t c = count_hood(CALL) - 1;
-    bool s = node.uid < 12;
+    bool s = node.uid < layout().lights();
+    // only people count, as lights in the same room can be in range of each other
+    int c = sum_hood(CALL, nbr(CALL, int(not s)), 0);
+    node.storage(occupants{}) = c;
     bool p = c > 0;
     real_t prob = p == old(CALL, p) ? STILL_FAIL : SWITCH_FAIL;
     bool a = s and ((node.next_real() < prob) != p);
+    record_propositions(CALL, uint64_t(s) | uint64_t(a) << 1 | uint64_t(p) << 2);
 
-    bool active_when_present = logic::active_when_present(CALL, s, a, p);
-    bool active_when_present_twice = logic::active_when_present_twice(CALL, s, a, p);
-    bool always_active_when_present = logic::always_active_when_present(CALL, s, a, p);
-    bool always_active_when_present_twice = logic::always_active_when_present_twice(CALL, s, a, p);
+    bool active_when_present = export_cost<local_strong_monitor, formula_payload<logic::fused::active_when_present>>(CALL, [&](){
+        return logic::active_when_present(CALL, s, a, p);
+    });
+    bool active_when_present_twice = export_cost<local_weak_monitor, formula_payload<logic::fused::active_when_present_twice>>(CALL, [&](){
+        return logic::active_when_present_twice(CALL, s, a, p);
+    });
+    bool always_active_when_present = export_cost<global_strong_monitor, formula_payload<logic::fused::always_active_when_present>>(CALL, [&](){
+        return logic::always_active_when_present(CALL, s, a, p);
+    });
+    bool always_active_when_present_twice = export_cost<global_weak_monitor, formula_payload<logic::fused::always_active_when_present_twice>>(CALL, [&](){
+        return logic::always_active_when_present_twice(CALL, s, a, p);
+    });
     assert(active_when_present <= active_when_present_twice);
     assert(always_active_when_present <= active_when_present);
     assert(always_active_when_present <= always_active_when_present_twice);
@@ -139,4 +276,124 @@ MAIN() {
 
 }
 
+//! @brief Namespace for all the simulation options.
+namespace option {
+
+//! @brief Simulation options of the smart home case study.
+inline namespace smart_home {
+
+using namespace component::tags;
+using namespace coordination::tags;
+
+//! @brief Number of atomic propositions recorded in traces (sensor, active and present).
+constexpr uint32_t trace_props = 3;
+
+//! @brief Number of lights in the building (of the default layout).
+constexpr size_t lights_num = 12;
+
+//! @brief Number of walking people in the building.
+constexpr size_t people_num = 12;
+
+//! @brief Dimensionality of the space.
+constexpr size_t dim = 3;
+
+//! @brief Final time for the plots.
+constexpr size_t end_time = 110;
+
+
+//! @brief Description of the round schedule.
+using round_s = sequence::periodic<
+    distribution::interval_n<times_t, 0, 1>,
+    distribution::weibull_n<times_t, 10, 1, 10>,
+    distribution::constant_n<times_t, 2*end_time>
+>;
+
+//! @brief Description of the export schedule.
+using export_s = sequence::periodic_n<1, 0, 1, end_time>;
+
+//! @brief Description of the sequence of node creation events.
+using spawn_s = sequence::multiple_n<lights_num + people_num, 0>;
+
+//! @brief Description of the initial position distribution.
+using rectangle_d = distribution::rect_n<1, 0, 0, 0, 24, 15, 0>;
+
+//! @brief Storage tags and types.
+using storage_t = tuple_store<
+    fail<local_strong_monitor>,     bool,
+    fail<local_weak_monitor>,       bool,
+    fail<global_strong_monitor>,    bool,
+    fail<global_weak_monitor>,      bool,
+    col,                            color,
+    size,                           double,
+    round_count,                    size_t,
+    occupants,                      int
+>;
+
+//! @brief Storage tags to be logged with aggregators.
+using aggregator_t = aggregators<
+    fail<local_strong_monitor>,     aggregator::mean<double>,
+    fail<local_weak_monitor>,       aggregator::mean<double>,
+    fail<global_strong_monitor>,    aggregator::mean<double>,
+    fail<global_weak_monitor>,      aggregator::mean<double>
+>;
+
+//! @brief Calls whose export size is statically estimated.
+//! @{
+using cost_storage_t = coordination::export_cost_store<local_strong_monitor, local_weak_monitor, global_strong_monitor, global_weak_monitor>;
+using cost_aggregator_t = coordination::export_cost_aggregators<local_strong_monitor, local_weak_monitor, global_strong_monitor, global_weak_monitor>;
+//! @}
+
+//! @brief Plot description.
+using plotter_t = coordination::export_cost_plotter<plot::plotter<aggregator_t, plot::time, fail>, cost_aggregator_t>;
+
+//! @brief Number of rounds performed by every device in generated buildings.
+constexpr size_t large_end_time = 50;
+
+//! @brief Description of the round schedule in generated buildings (synchronous, to measure every round).
+using large_round_s = sequence::periodic_n<1, 0, 1, large_end_time-1>;
+
+//! @brief Options list for generated buildings (without plots, devices to be created through `node_emplace`).
+template <bool parallel_flag>
+DECLARE_OPTIONS(large_list,
+    parallel<parallel_flag>,
+    synchronised<false>,
+    dimension<dim>,
+    program<coordination::main>,
+    exports<vec<dim>, bool, int, coordination::export_cost_t>,
+    retain<metric::retain<2,1>>,
+    connector<connect::fixed<4, 1, dim>>,
+    round_schedule<large_round_s>,
+    storage_t,
+    cost_storage_t
+);
+
+//! @brief Options list (with a given plotter type, the plot description by default).
+template <bool parallel_flag, typename plot_t = plotter_t>
+DECLARE_OPTIONS(list,
+    parallel<parallel_flag>,
+    synchronised<false>,
+    dimension<dim>,
+    program<coordination::main>,
+    exports<vec<dim>, bool, int, coordination::export_cost_t>,
+    retain<metric::retain<2,1>>,
+    connector<connect::fixed<4, 1, dim>>,
+    round_schedule<round_s>,
+    log_schedule<export_s>,
+    spawn_schedule<spawn_s>,
+    init<x, rectangle_d>,
+    storage_t,
+    aggregator_t,
+    cost_storage_t,
+    cost_aggregator_t,
+    plot_type<plot_t>,
+    size_tag<size>,
+    color_tag<col>
+);
+
+}
+
+}
+
+}
+
 #endif // FCPP_SMART_HOME_H_
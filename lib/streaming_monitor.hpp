@@ -0,0 +1,254 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file streaming_monitor.hpp
+ * @brief Networks of monitors driven by external streams of proposition and neighbourhood events.
+ *
+ * A `streaming::network` evaluates a set of fused formulas on devices known only through the events
+ * it is fed in batches: links appearing or disappearing between devices, and rounds of a device with
+ * its current propositions (as a bitmask). Every round evaluates the monitors of the device as in
+ * trace replay, against the last states of its current neighbours, and yields a verdict per monitor.
+ *
+ * Events can also be read from a text stream (a file, a pipe or a socket), one per line:
+ * `p time uid props` for a round, `+ a b` and `- a b` for a link between `a` and `b` appearing or
+ * disappearing. An empty line (or a line with a single `.`) ends a batch.
+ */
+
+#ifndef FCPP_STREAMING_MONITOR_H_
+#define FCPP_STREAMING_MONITOR_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/failure_stats.hpp"
+#include "lib/logic_samples.hpp"
+#include "lib/proposition_trace.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace for monitors driven by external event streams.
+namespace streaming {
+
+//! @brief Builder of a monitor, given the bits of its propositions in the bitmasks of rounds.
+using factory_t = std::function<std::unique_ptr<proposition_trace::replay_base>(std::vector<size_t>)>;
+
+//! @brief Builder of a monitor of formula F (a distributed `replay_monitor` by default, or a `reference_monitor`).
+template <typename F, template <typename> class M = proposition_trace::replay_monitor>
+factory_t factory() {
+    return [](std::vector<size_t> bits) {
+        return std::unique_ptr<proposition_trace::replay_base>(new M<F>(std::move(bits)));
+    };
+}
+
+//! @brief The formulas that can be monitored, by name (with monitors of kind M).
+template <template <typename> class M = proposition_trace::replay_monitor>
+std::map<std::string, factory_t> const& formulas() {
+    using namespace coordination::logic;
+    static std::map<std::string, factory_t> const m = {
+        {"my_unwanted_response",                factory<fused::my_unwanted_response, M>()},
+        {"no_unwanted_response",                factory<fused::no_unwanted_response, M>()},
+        {"my_double_request",                   factory<fused::my_double_request, M>()},
+        {"no_double_request",                   factory<fused::no_double_request, M>()},
+        {"no_reply<5>",                         factory<fused::no_reply<5>, M>()},
+        {"all_response_time<5>",                factory<fused::all_response_time<5>, M>()},
+        {"my_safety_preserved",                 factory<fused::my_safety_preserved, M>()},
+        {"all_safety_preserved",                factory<fused::all_safety_preserved, M>()},
+        {"area_handled",                        factory<fused::area_handled, M>()},
+        {"no_redundancy",                       factory<fused::no_redundancy, M>()},
+        {"active_when_present",                 factory<fused::active_when_present, M>()},
+        {"always_active_when_present",          factory<fused::always_active_when_present, M>()},
+        {"active_when_present_twice",           factory<fused::active_when_present_twice, M>()},
+        {"always_active_when_present_twice",    factory<fused::always_active_when_present_twice, M>()}
+    };
+    return m;
+}
+
+/**
+ * @brief Builds a monitor of kind M given as `formula[:bit,bit...]`.
+ *
+ * The bits give the propositions of the formula in the bitmasks of rounds (defaulting to the first
+ * `nprops` in order). Throws if the formula is unknown, or if a bit is not less than `max_props`.
+ */
+template <template <typename> class M = proposition_trace::replay_monitor>
+std::unique_ptr<proposition_trace::replay_base> make_monitor(std::string const& spec, size_t nprops = proposition_trace::max_props) {
+    std::string name = spec.substr(0, spec.find(':'));
+    std::vector<size_t> bits;
+    if (name.size() < spec.size()) {
+        std::stringstream ss(spec.substr(name.size() + 1));
+        for (std::string b; std::getline(ss, b, ',');) bits.push_back(std::stoul(b));
+    } else for (size_t b = 0; b < nprops; ++b) bits.push_back(b);
+    if (formulas<M>().count(name) == 0) throw std::invalid_argument("unknown formula " + name);
+    return formulas<M>().at(name)(bits);
+}
+
+#ifdef FCPP_MULTI_RUNNER
+//! @brief The monitors of every formula, of both kinds (see `lib/monitor_instances.cpp`).
+//! @{
+extern template std::map<std::string, factory_t> const& formulas<proposition_trace::replay_monitor>();
+extern template std::map<std::string, factory_t> const& formulas<proposition_trace::reference_monitor>();
+extern template std::unique_ptr<proposition_trace::replay_base> make_monitor<proposition_trace::replay_monitor>(std::string const&, size_t);
+extern template std::unique_ptr<proposition_trace::replay_base> make_monitor<proposition_trace::reference_monitor>(std::string const&, size_t);
+//! @}
+#endif
+
+//! @brief An event fed to a network of monitors.
+struct event {
+    //! @brief Kinds of events.
+    enum kind_t : char { round = 'p', link = '+', unlink = '-' };
+    //! @brief The kind of event.
+    kind_t kind;
+    //! @brief Time of the round.
+    double time;
+    //! @brief The device of the round, or the first end of the link.
+    uint32_t uid;
+    //! @brief The second end of the link.
+    uint32_t other;
+    //! @brief The propositions of the device in the round.
+    uint64_t props;
+};
+
+//! @brief The value of a monitor in a round.
+struct verdict {
+    //! @brief Time of the round.
+    double time;
+    //! @brief The device of the round.
+    uint32_t uid;
+    //! @brief Index of the monitor.
+    uint32_t monitor;
+    //! @brief Value of the monitor.
+    bool value;
+};
+
+//! @brief Network of monitors, fed with batches of events.
+class network {
+  public:
+    //! @brief Constructor, given the monitors as `formula[:bit,bit...]`.
+    network(std::vector<std::string> const& specs, size_t nprops = proposition_trace::max_props) : m_names(specs) {
+        for (std::string const& s : specs) m_monitors.push_back(make_monitor(s, nprops));
+    }
+
+    //! @brief Names of the monitors.
+    std::vector<std::string> const& names() const {
+        return m_names;
+    }
+
+    //! @brief Processes a batch of events in order, returning the verdicts of its rounds.
+    std::vector<verdict> const& process(std::vector<event> const& batch) {
+        auto start = std::chrono::steady_clock::now();
+        m_verdicts.clear();
+        for (event const& e : batch) {
+            if (e.kind == event::round) {
+                std::vector<uint32_t> const& n = m_nbrs[e.uid];
+                proposition_trace::reader::record r{e.time, e.uid, e.props, uint32_t(n.size()), reinterpret_cast<char const*>(n.data())};
+                for (size_t i = 0; i < m_monitors.size(); ++i)
+                    m_verdicts.push_back({e.time, e.uid, uint32_t(i), m_monitors[i]->step(r)});
+            } else {
+                connect(e.uid, e.other, e.kind == event::link);
+                connect(e.other, e.uid, e.kind == event::link);
+            }
+        }
+        m_events += batch.size();
+        double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        m_latency.insert(latency);
+        m_busy += latency;
+        return m_verdicts;
+    }
+
+    //! @brief Number of events processed.
+    size_t events() const {
+        return m_events;
+    }
+
+    //! @brief Number of batches processed.
+    size_t batches() const {
+        return m_latency.count();
+    }
+
+    //! @brief Total time spent processing batches (in seconds).
+    double busy() const {
+        return m_busy;
+    }
+
+    //! @brief Estimate of the q-quantile of the latency of batches (in seconds, within the error of `log_sketch`).
+    double latency(double q) const {
+        if (m_latency.count() == 0) return 0;
+        return m_latency.quantile(q);
+    }
+
+  private:
+    //! @brief Adds or removes b from the neighbours of a.
+    void connect(uint32_t a, uint32_t b, bool add) {
+        std::vector<uint32_t>& n = m_nbrs[a];
+        auto it = std::find(n.begin(), n.end(), b);
+        if (add and it == n.end()) n.push_back(b);
+        if (not add and it != n.end()) {
+            *it = n.back();
+            n.pop_back();
+        }
+    }
+
+    //! @brief Names of the monitors.
+    std::vector<std::string> m_names;
+
+    //! @brief The monitors.
+    std::vector<std::unique_ptr<proposition_trace::replay_base>> m_monitors;
+
+    //! @brief Current neighbours of every device.
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_nbrs;
+
+    //! @brief Verdicts of the last batch.
+    std::vector<verdict> m_verdicts;
+
+    //! @brief Number of events processed.
+    size_t m_events = 0;
+
+    //! @brief Histogram of the latency of the batches processed (in constant memory).
+    log_sketch m_latency;
+
+    //! @brief Total time spent processing batches.
+    double m_busy = 0;
+};
+
+/**
+ * @brief Reads a batch of at most `max` events from a text stream, returning false at its end.
+ *
+ * Throws on malformed lines.
+ */
+inline bool read_batch(FILE* in, std::vector<event>& batch, size_t max = 4096) {
+    batch.clear();
+    char line[256];
+    while (batch.size() < max and std::fgets(line, sizeof(line), in)) {
+        event e{event::round, 0, 0, 0, 0};
+        unsigned long long props;
+        if (line[0] == '\n' or (line[0] == '.' and (line[1] == '\n' or line[1] == 0))) {
+            if (batch.empty()) continue;
+            return true;
+        } else if (line[0] == 'p' and std::sscanf(line + 1, "%lf %u %llu", &e.time, &e.uid, &props) == 3) {
+            e.props = props;
+        } else if ((line[0] == '+' or line[0] == '-') and std::sscanf(line + 1, "%u %u", &e.uid, &e.other) == 2) {
+            e.kind = event::kind_t(line[0]);
+        } else throw std::invalid_argument(std::string("invalid event ") + line);
+        batch.push_back(e);
+    }
+    return not batch.empty();
+}
+
+}
+
+}
+
+#endif // FCPP_STREAMING_MONITOR_H_
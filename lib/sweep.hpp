@@ -0,0 +1,214 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file sweep.hpp
+ * @brief Parameter sweeps of the case studies, running independent networks on a thread pool.
+ *
+ * Case studies read their tunable parameters through `sweep::current<P>()`, which gives the
+ * parameter set `P` of the process, unless the current thread overrides it. A sweep runs every
+ * point of a grid of parameter values for every seed as a separate sequential network (overriding
+ * parameters in the thread running it), on a pool of threads, and summarises each run by the
+ * average over time of every aggregator in a table keyed by parameters and seed.
+ */
+
+#ifndef FCPP_SWEEP_H_
+#define FCPP_SWEEP_H_
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace for parameter sweeps of case studies.
+namespace sweep {
+
+//! @brief The parameters of type P of the process (applying to threads that do not override them).
+template <typename P>
+P& defaults() {
+    static P p;
+    return p;
+}
+
+//! @brief The parameters of type P overridden by the current thread (null if not overridden).
+template <typename P>
+P*& overridden() {
+    thread_local P* p = nullptr;
+    return p;
+}
+
+/**
+ * @brief The parameters of type P used by the current thread.
+ *
+ * Networks should be sequential for parameters overridden by a thread to apply to all of their nodes.
+ */
+template <typename P>
+P& current() {
+    P* p = overridden<P>();
+    return p ? *p : defaults<P>();
+}
+
+//! @brief Values taken by a parameter in a sweep.
+struct axis {
+    //! @brief Name of the parameter.
+    std::string name;
+    //! @brief Values of the parameter.
+    std::vector<double> values;
+};
+
+//! @brief Parses an axis as `name=v1,v2,...` or `name=first:last:step`, with at least one value.
+inline axis parse_axis(std::string const& arg) {
+    size_t eq = arg.find('=');
+    if (eq == std::string::npos) throw std::invalid_argument("invalid sweep axis " + arg);
+    axis a{arg.substr(0, eq), {}};
+    std::string vals = arg.substr(eq + 1);
+    if (vals.find(':') != std::string::npos) {
+        double first, last, step;
+        char c1, c2;
+        std::stringstream ss(vals);
+        if (not (ss >> first >> c1 >> last >> c2 >> step) or step <= 0) throw std::invalid_argument("invalid sweep range " + arg);
+        for (size_t i = 0; first + i * step <= last + step * 1e-9; ++i) a.values.push_back(first + i * step);
+    } else {
+        std::stringstream ss(vals);
+        for (std::string v; std::getline(ss, v, ',');) {
+            if (v.empty()) throw std::invalid_argument("empty value in sweep axis " + arg);
+            a.values.push_back(std::stod(v));
+        }
+    }
+    if (a.values.empty()) throw std::invalid_argument("no values in sweep axis " + arg);
+    return a;
+}
+
+//! @brief Plotter summarising the rows logged by the average of every column (skipping undefined values).
+class summary {
+  public:
+    //! @brief Accumulates a row.
+    template <typename... Ss, typename... Ts>
+    summary& operator<<(common::tagged_tuple<common::type_sequence<Ss...>, common::type_sequence<Ts...>> const& row) {
+        if (m_names.empty()) {
+            m_names = {common::strip_namespaces(common::type_name<Ss>())...};
+            m_sums.assign(m_names.size(), 0);
+            m_rows.assign(m_names.size(), 0);
+        }
+        size_t c = 0;
+        for (double x : {static_cast<double>(common::get<Ss>(row))...}) {
+            if (not std::isnan(x)) {
+                m_sums[c] += x;
+                ++m_rows[c];
+            }
+            ++c;
+        }
+        return *this;
+    }
+
+    //! @brief Names of the columns.
+    std::vector<std::string> const& names() const {
+        return m_names;
+    }
+
+    //! @brief Forgets the rows accumulated so far.
+    void clear() {
+        m_sums.assign(m_sums.size(), 0);
+        m_rows.assign(m_rows.size(), 0);
+    }
+
+    //! @brief Averages of the columns.
+    std::vector<double> means() const {
+        std::vector<double> v = m_sums;
+        for (size_t c = 0; c < v.size(); ++c) v[c] /= m_rows[c];
+        return v;
+    }
+
+  private:
+    //! @brief Names of the columns.
+    std::vector<std::string> m_names;
+
+    //! @brief Sums of the columns.
+    std::vector<double> m_sums;
+
+    //! @brief Number of rows accumulated with a value, for every column.
+    std::vector<size_t> m_rows;
+};
+
+//! @brief Values of the parameters in a point of the grid of a sweep.
+inline std::vector<double> point_values(std::vector<axis> const& axes, size_t point) {
+    std::vector<double> v(axes.size());
+    for (size_t i = axes.size(); i-- > 0; point /= axes[i].values.size())
+        v[i] = axes[i].values[point % axes[i].values.size()];
+    return v;
+}
+
+//! @brief Prints the table of a sweep as tab-separated values, given the parameters and results of every run.
+inline void print_table(std::ostream& out, std::vector<axis> const& axes, size_t seeds, std::vector<std::vector<double>> const& params, std::vector<std::string> const& columns, std::vector<std::vector<double>> const& results) {
+    for (axis const& a : axes) out << a.name << "\t";
+    out << "seed";
+    for (std::string const& c : columns) out << "\t" << c;
+    out << "\n";
+    for (size_t job = 0; job < params.size(); ++job) {
+        for (double v : params[job]) out << v << "\t";
+        out << job % seeds;
+        for (double v : results[job]) out << "\t" << v;
+        out << "\n";
+    }
+}
+
+/**
+ * @brief Runs a sweep, printing the resulting table as tab-separated values.
+ *
+ * The options `opt` should describe a sequential network with `summary` as plotter, and the
+ * parameters P should have a member `bool set(std::string, double)` returning whether a parameter exists.
+ */
+template <typename opt, typename P>
+void run(std::vector<axis> const& axes, size_t seeds, size_t threads, std::ostream& out = std::cout) {
+    P base;
+    for (axis const& a : axes)
+        if (not base.set(a.name, a.values.front())) throw std::invalid_argument("unknown parameter " + a.name);
+    size_t npoints = 1;
+    for (axis const& a : axes) npoints *= a.values.size();
+    size_t njobs = npoints * seeds;
+    std::vector<std::vector<double>> params(njobs), results(njobs);
+    std::vector<std::string> columns;
+    std::atomic<size_t> next{0};
+    auto start = std::chrono::steady_clock::now();
+    auto worker = [&](){
+        for (size_t job; (job = next++) < njobs;) {
+            P p = base;
+            overridden<P>() = &p;
+            params[job] = point_values(axes, job / seeds);
+            for (size_t i = 0; i < axes.size(); ++i) p.set(axes[i].name, params[job][i]);
+            summary s;
+            {
+                typename component::batch_simulator<opt>::net network{common::make_tagged_tuple<component::tags::plotter, component::tags::seed>(&s, job % seeds)};
+                network.run();
+            }
+            overridden<P>() = nullptr;
+            results[job] = s.means();
+            if (job == 0) columns = s.names();
+        }
+    };
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < std::min(threads, njobs); ++i) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    print_table(out, axes, seeds, params, columns, results);
+    std::cerr << njobs << " runs (" << npoints << " points, " << seeds << " seeds) on " << threads << " threads in " << wall << " s\n";
+}
+
+}
+
+}
+
+#endif // FCPP_SWEEP_H_
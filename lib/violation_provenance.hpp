@@ -0,0 +1,236 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file violation_provenance.hpp
+ * @brief Fixed-memory record of the last rounds of every node, dumped when a monitor starts failing.
+ *
+ * When `FCPP_PROVENANCE` is defined, every node keeps the last `provenance::depth` rounds (time, round number, number of neighbours,
+ * propositions and monitor values as bitmasks) in a ring buffer in its storage. When a watched monitor
+ * turns from satisfied to violated, the ring is written as it is to the dump file (if one is open),
+ * together with the origin of the violation: the earliest round of a node whose local condition was
+ * violated, propagated among the neighbouring nodes which are violating the monitor. Since origins
+ * are only exchanged by nodes violating the monitor, and writing the ring takes a few stores, the
+ * cost of a round without violations is negligible.
+ *
+ * A dump file is made of a block per flip, starting with a header line
+ * `# flip <monitor> uid <uid> round <round> time <time> origin <uid> round <round> time <time>`
+ * followed by the rounds in the ring from the oldest, as `time round neighbours props values` with
+ * the bitmasks in hexadecimal. The block of the flip at the origin node (if recorded) has the origin
+ * uid as uid.
+ *
+ * Otherwise, nodes keep no ring (`provenance_store` is empty), `record_provenance` does nothing and
+ * `watch_violation` exchanges no origins, so that the case studies pay nothing for provenance.
+ */
+
+#ifndef FCPP_VIOLATION_PROVENANCE_H_
+#define FCPP_VIOLATION_PROVENANCE_H_
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace for the provenance of monitor violations.
+namespace provenance {
+
+//! @brief Number of rounds kept by every node.
+constexpr size_t depth = 32;
+
+//! @brief Ring buffer of the last rounds of a node.
+class ring {
+  public:
+    //! @brief A round of the node.
+    struct entry {
+        //! @brief Time of the round.
+        double time;
+        //! @brief Number of the round.
+        uint32_t round;
+        //! @brief Number of neighbours.
+        uint32_t nbrs;
+        //! @brief Propositions of the node.
+        uint64_t props;
+        //! @brief Values of monitors and subformulas of the node.
+        uint64_t values;
+    };
+
+    //! @brief Records a round.
+    void push(entry const& e) {
+        m_data[m_rounds++ % depth] = e;
+    }
+
+    //! @brief Number of rounds recorded so far.
+    uint32_t rounds() const {
+        return m_rounds;
+    }
+
+    //! @brief Number of rounds kept.
+    size_t size() const {
+        return m_rounds < depth ? m_rounds : depth;
+    }
+
+    //! @brief The i-th round kept, from the oldest.
+    entry const& operator[](size_t i) const {
+        return m_data[(m_rounds - size() + i) % depth];
+    }
+
+    //! @brief Bitmask of the watched monitors which were violated in the last round.
+    uint64_t& violated() {
+        return m_violated;
+    }
+
+  private:
+    //! @brief The rounds kept.
+    std::array<entry, depth> m_data;
+
+    //! @brief Number of rounds recorded.
+    uint32_t m_rounds = 0;
+
+    //! @brief Bitmask of violated monitors.
+    uint64_t m_violated = 0;
+};
+
+//! @brief Origin of a violation: time, uid and round of the node where it started.
+using origin_t = tuple<times_t, device_t, uint32_t>;
+
+//! @brief The origin of no violation.
+inline origin_t none() {
+    return {TIME_MAX, std::numeric_limits<device_t>::max(), 0};
+}
+
+//! @brief Writer of the rings of nodes with a monitor flip, shared by all the nodes of a process.
+class dumper {
+  public:
+    //! @brief The dumper of the process.
+    static dumper& instance() {
+        static dumper d;
+        return d;
+    }
+
+    //! @brief Starts dumping to a file.
+    void open(std::string const& path) {
+#ifndef FCPP_PROVENANCE
+        throw std::runtime_error("cannot dump provenance to " + path + ": configure with -DFCPP_PROVENANCE=ON");
+#endif
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_file = std::fopen(path.c_str(), "w");
+        if (m_file == nullptr) throw std::runtime_error("cannot open provenance file " + path);
+    }
+
+    //! @brief Stops dumping.
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_file) std::fclose(m_file);
+        m_file = nullptr;
+    }
+
+    //! @brief Whether the dumper is active.
+    bool active() const {
+        return m_file != nullptr;
+    }
+
+    //! @brief Writes the ring of a node where a monitor started failing, with the origin of the violation.
+    void dump(char const* monitor, device_t uid, origin_t const& origin, ring const& r) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_file == nullptr) return;
+        ring::entry const& last = r[r.size() - 1];
+        std::fprintf(m_file, "# flip %s uid %llu round %u time %g origin %llu round %u time %g\n", monitor,
+                     (unsigned long long)uid, last.round, last.time,
+                     (unsigned long long)get<1>(origin), get<2>(origin), double(get<0>(origin)));
+        for (size_t i = 0; i < r.size(); ++i)
+            std::fprintf(m_file, "%g %u %u %llx %llx\n", r[i].time, r[i].round, r[i].nbrs,
+                         (unsigned long long)r[i].props, (unsigned long long)r[i].values);
+    }
+
+    //! @brief Destructor, flushing the file.
+    ~dumper() {
+        close();
+    }
+
+  private:
+    //! @brief The file being written.
+    FILE* m_file = nullptr;
+
+    //! @brief Mutex serialising writes from different threads.
+    std::mutex m_mutex;
+};
+
+}
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+namespace tags {
+    //! @brief Ring buffer of the last rounds of the current node.
+    struct provenance_ring {};
+}
+
+#ifdef FCPP_PROVENANCE
+//! @brief Storage tags for violation provenance.
+using provenance_store = component::tags::tuple_store<tags::provenance_ring, provenance::ring>;
+
+//! @brief The types used in export by violation provenance.
+FUN_EXPORT provenance_t = common::export_list<provenance::origin_t>;
+
+//! @brief Records the current round in the ring of the node, with its propositions and monitor values.
+FUN void record_provenance(ARGS, uint64_t props, uint64_t values) { CODE
+    provenance::ring& r = node.storage(tags::provenance_ring{});
+    r.push({node.current_time(), r.rounds(), uint32_t(fcpp::details::get_ids(node.nbr_uid()).size()), props, values});
+}
+
+/**
+ * @brief Watches the i-th monitor of the node (less than 64), returning the origin of its violation.
+ *
+ * @param violated Whether the monitor is violated.
+ * @param local Whether the local condition of the monitor is violated (starting a violation).
+ *
+ * Should be called after `record_provenance` in the round. If the monitor started failing, the ring of
+ * the node is dumped.
+ */
+FUN provenance::origin_t watch_violation(ARGS, size_t i, char const* monitor, bool violated, bool local) { CODE
+    using provenance::origin_t;
+    provenance::ring& r = node.storage(tags::provenance_ring{});
+    bool flipped = violated and not ((r.violated() >> i) & 1);
+    r.violated() = (r.violated() & ~(uint64_t(1) << i)) | (uint64_t(violated) << i);
+    if (not violated) return provenance::none();
+    // earliest local violation among the neighbours violating the monitor
+    origin_t mine = local ? origin_t{node.current_time(), node.uid, r.rounds() - 1} : provenance::none();
+    origin_t origin = nbr(CALL, mine, [&](field<origin_t> o){
+        return std::min(fold_hood(CALL, [](origin_t const& x, origin_t const& y){
+            return std::min(x, y);
+        }, o), mine);
+    });
+    if (flipped and provenance::dumper::instance().active()) provenance::dumper::instance().dump(monitor, node.uid, origin, r);
+    return origin;
+}
+#else
+//! @brief Storage tags for violation provenance (none, provenance disabled).
+using provenance_store = component::tags::tuple_store<>;
+
+//! @brief The types used in export by violation provenance (none, provenance disabled).
+FUN_EXPORT provenance_t = common::export_list<>;
+
+//! @brief Records the current round (provenance disabled).
+FUN void record_provenance(ARGS, uint64_t, uint64_t) { CODE}
+
+//! @brief Watches the i-th monitor of the node (provenance disabled, no origin).
+FUN provenance::origin_t watch_violation(ARGS, size_t, char const*, bool, bool) { CODE
+    return provenance::none();
+}
+#endif
+
+}
+
+}
+
+#endif // FCPP_VIOLATION_PROVENANCE_H_
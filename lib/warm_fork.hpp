@@ -0,0 +1,145 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file warm_fork.hpp
+ * @brief What-if sweeps forking every variant from a single warm network.
+ *
+ * The network is run with the default parameters up to a warm-up time, and the process is then
+ * forked once per point of the parameter grid. Every child process inherits the whole state of the
+ * network at the fork (node storage, exports, `old` and `constant` values, positions, schedules and
+ * random generators) through copy-on-write memory, changes its parameters and continues the run,
+ * sending its summary back to the parent through a pipe. The warm-up is thus computed once for all
+ * the variants, which start from exactly the same state. The summary of a variant only averages the
+ * rows logged after the fork, so the warm-up (common to every variant) does not dilute the differences.
+ * Forking requires a POSIX system.
+ */
+
+#ifndef FCPP_WARM_FORK_H_
+#define FCPP_WARM_FORK_H_
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "lib/fcpp.hpp"
+#include "lib/sweep.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace for parameter sweeps of case studies.
+namespace sweep {
+
+//! @cond INTERNAL
+namespace details {
+    //! @brief Writes a whole string to a file descriptor.
+    inline void write_all(int fd, std::string const& s) {
+        for (size_t pos = 0; pos < s.size();) {
+            ssize_t n = ::write(fd, s.data() + pos, s.size() - pos);
+            if (n <= 0) return;
+            pos += n;
+        }
+    }
+
+    //! @brief Reads a file descriptor until its end.
+    inline std::string read_all(int fd) {
+        std::string s;
+        char buf[4096];
+        for (ssize_t n; (n = ::read(fd, buf, sizeof(buf))) > 0;) s.append(buf, n);
+        return s;
+    }
+}
+//! @endcond
+
+/**
+ * @brief Runs a sweep forking every point from a network warmed up to a given time, printing the resulting table.
+ *
+ * At most `jobs` child processes run at a time. The options `opt` should describe a sequential
+ * network with `summary` as plotter (whose averages exclude the warm-up), and the parameters P should
+ * have a member `bool set(std::string, double)` returning whether a parameter exists.
+ */
+template <typename opt, typename P>
+void warm_fork(times_t warmup, std::vector<axis> const& axes, size_t jobs, std::ostream& out = std::cout) {
+    for (axis const& a : axes)
+        if (not P{}.set(a.name, a.values.front())) throw std::invalid_argument("unknown parameter " + a.name);
+    size_t npoints = 1;
+    for (axis const& a : axes) npoints *= a.values.size();
+    std::vector<std::vector<double>> params(npoints), results(npoints);
+    std::vector<std::string> columns;
+    auto start = std::chrono::steady_clock::now();
+    summary s;
+    typename component::batch_simulator<opt>::net network{common::make_tagged_tuple<component::tags::plotter>(&s)};
+    while (network.next() < warmup) network.update();
+    double warm = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // running children, with the pipe of their results and their point
+    struct child {
+        pid_t pid;
+        int fd;
+        size_t point;
+    };
+    std::deque<child> running;
+    auto collect = [&](){
+        child c = running.front();
+        running.pop_front();
+        std::stringstream ss(details::read_all(c.fd));
+        ::close(c.fd);
+        ::waitpid(c.pid, nullptr, 0);
+        std::string names, values;
+        std::getline(ss, names);
+        std::getline(ss, values);
+        if (values.empty()) throw std::runtime_error("variant " + std::to_string(c.point) + " failed");
+        if (columns.empty()) {
+            std::stringstream ns(names);
+            for (std::string n; std::getline(ns, n, '\t');) columns.push_back(n);
+        }
+        std::stringstream vs(values);
+        for (double v; vs >> v;) results[c.point].push_back(v);
+    };
+    std::cout.flush();
+    std::cerr.flush();
+    for (size_t point = 0; point < npoints; ++point) {
+        params[point] = point_values(axes, point);
+        while (running.size() >= std::max(jobs, size_t(1))) collect();
+        int fd[2];
+        if (::pipe(fd) != 0) throw std::runtime_error("cannot create pipe");
+        pid_t pid = ::fork();
+        if (pid < 0) throw std::runtime_error("cannot fork");
+        if (pid == 0) {
+            ::close(fd[0]);
+            for (size_t i = 0; i < axes.size(); ++i) defaults<P>().set(axes[i].name, params[point][i]);
+            s.clear();
+            network.run();
+            std::stringstream ss;
+            ss.precision(17);
+            for (std::string const& n : s.names()) ss << n << "\t";
+            ss << "\n";
+            for (double v : s.means()) ss << v << "\t";
+            ss << "\n";
+            details::write_all(fd[1], ss.str());
+            ::_exit(0);
+        }
+        ::close(fd[1]);
+        running.push_back({pid, fd[0], point});
+    }
+    while (not running.empty()) collect();
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    print_table(out, axes, 1, params, columns, results);
+    std::cerr << npoints << " variants forked at time " << warmup << " (warm-up in " << warm << " s) on " << jobs << " processes in " << wall << " s\n";
+}
+
+}
+
+}
+
+#endif // FCPP_WARM_FORK_H_
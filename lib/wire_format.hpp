@@ -0,0 +1,222 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file wire_format.hpp
+ * @brief Compact encodings of exported values: quantized reals and vectors, and delta-encoded messages.
+ *
+ * Quantized types travel in exports as integer multiples of a precision given as a `std::ratio`,
+ * and convert implicitly from and to the corresponding real types. Delta encoding stores a message
+ * as the difference from the previous one sent by the same device: runs of unchanged bytes take a
+ * single variable-length integer, so that values that did not change in the round (as most booleans
+ * in monitors) cost almost nothing. Receivers decode each message against the last one they received
+ * from the same neighbour, and need a key frame (a message encoded against an empty one) whenever
+ * they missed some.
+ */
+
+#ifndef FCPP_WIRE_FORMAT_H_
+#define FCPP_WIRE_FORMAT_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <ratio>
+#include <vector>
+
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+/**
+ * @brief Real number exported as an integer multiple of a given precision.
+ *
+ * @param P The precision (a `std::ratio`).
+ * @param I The integral type used in exports.
+ */
+template <typename P, typename I = int32_t>
+class quantized {
+  public:
+    //! @brief Default constructor (zero).
+    quantized() : m_value(0) {}
+
+    //! @brief Conversion from a real number, rounded to the closest multiple of the precision.
+    quantized(real_t x) : m_value(I(std::llround(x * P::den / P::num))) {}
+
+    //! @brief Conversion to a real number.
+    operator real_t() const {
+        return real_t(m_value) * P::num / P::den;
+    }
+
+    //! @brief Equality.
+    friend bool operator==(quantized const& x, quantized const& y) {
+        return x.m_value == y.m_value;
+    }
+
+    //! @brief Inequality.
+    friend bool operator!=(quantized const& x, quantized const& y) {
+        return x.m_value != y.m_value;
+    }
+
+    //! @brief Ordering.
+    friend bool operator<(quantized const& x, quantized const& y) {
+        return x.m_value < y.m_value;
+    }
+
+    //! @brief Serialises the content from/to a given input/output stream.
+    template <typename S>
+    S& serialize(S& s) {
+        return s & m_value;
+    }
+
+    //! @brief Serialises the content from/to a given input/output stream (const overload).
+    template <typename S>
+    S& serialize(S& s) const {
+        return s << m_value;
+    }
+
+  private:
+    //! @brief The value, in multiples of the precision.
+    I m_value;
+};
+
+/**
+ * @brief Vector exported with every coordinate as an integer multiple of a given precision.
+ *
+ * @param n The dimension.
+ * @param P The precision (a `std::ratio`).
+ * @param I The integral type used in exports.
+ */
+template <size_t n, typename P, typename I = int32_t>
+class quantized_vec {
+  public:
+    //! @brief Default constructor (origin).
+    quantized_vec() : m_data{} {}
+
+    //! @brief Conversion from a vector, rounding coordinates to the closest multiple of the precision.
+    quantized_vec(vec<n> const& v) {
+        for (size_t i = 0; i < n; ++i) m_data[i] = I(std::llround(v[i] * P::den / P::num));
+    }
+
+    //! @brief Conversion to a vector.
+    operator vec<n>() const {
+        vec<n> v;
+        for (size_t i = 0; i < n; ++i) v[i] = real_t(m_data[i]) * P::num / P::den;
+        return v;
+    }
+
+    //! @brief Equality.
+    friend bool operator==(quantized_vec const& x, quantized_vec const& y) {
+        return x.m_data == y.m_data;
+    }
+
+    //! @brief Inequality.
+    friend bool operator!=(quantized_vec const& x, quantized_vec const& y) {
+        return x.m_data != y.m_data;
+    }
+
+    //! @brief Ordering.
+    friend bool operator<(quantized_vec const& x, quantized_vec const& y) {
+        return x.m_data < y.m_data;
+    }
+
+    //! @brief Serialises the content from/to a given input/output stream.
+    template <typename S>
+    S& serialize(S& s) {
+        return s & m_data;
+    }
+
+    //! @brief Serialises the content from/to a given input/output stream (const overload).
+    template <typename S>
+    S& serialize(S& s) const {
+        return s << m_data;
+    }
+
+  private:
+    //! @brief The coordinates, in multiples of the precision.
+    std::array<I, n> m_data;
+};
+
+//! @brief Namespace for compact encodings of messages.
+namespace wire {
+
+//! @brief Appends an unsigned integer with a variable number of bytes (7 bits each).
+inline void put_varint(std::vector<char>& out, size_t x) {
+    for (; x >= 128; x >>= 7) out.push_back(char((x & 127) | 128));
+    out.push_back(char(x));
+}
+
+//! @brief Reads an unsigned integer with a variable number of bytes, advancing the position.
+inline size_t get_varint(std::vector<char> const& in, size_t& pos) {
+    size_t x = 0;
+    for (size_t shift = 0; pos < in.size(); shift += 7) {
+        unsigned char c = in[pos++];
+        if (shift < 64) x |= size_t(c & 127) << shift;
+        if (c < 128) break;
+    }
+    return x;
+}
+
+/**
+ * @brief Encodes a message as difference from the previous one.
+ *
+ * The encoding is the size of the message followed by pairs of runs, the first of bytes equal to
+ * the previous message (its length only) and the second of changed bytes (its length and content).
+ */
+inline std::vector<char> delta_encode(std::vector<char> const& prev, std::vector<char> const& cur) {
+    std::vector<char> out;
+    put_varint(out, cur.size());
+    auto same = [&](size_t i){
+        return i < prev.size() and prev[i] == cur[i];
+    };
+    for (size_t i = 0; i < cur.size();) {
+        size_t j = i;
+        while (j < cur.size() and same(j)) ++j;
+        size_t k = j;
+        while (k < cur.size() and not same(k)) ++k;
+        put_varint(out, j - i);
+        put_varint(out, k - j);
+        out.insert(out.end(), cur.begin() + j, cur.begin() + k);
+        i = k;
+    }
+    return out;
+}
+
+/**
+ * @brief Decodes a message encoded as difference from the previous one, returning whether it succeeded.
+ *
+ * Decoding fails if the encoding is truncated, or refers to bytes beyond the end of the previous
+ * message (e.g. because the receiver missed some messages): the sender should then send a key
+ * frame, that is, the message encoded against an empty previous one, which always decodes. The
+ * content of `cur` is unspecified after a failure.
+ */
+inline bool delta_decode(std::vector<char> const& prev, std::vector<char> const& enc, std::vector<char>& cur) {
+    size_t pos = 0;
+    size_t n = get_varint(enc, pos);
+    // every byte comes either from the previous message at the same position, or from the encoding
+    if (n > prev.size() + enc.size()) return false;
+    cur.resize(n);
+    for (size_t i = 0; i < n;) {
+        if (pos >= enc.size()) return false;
+        size_t same = get_varint(enc, pos);
+        if (same > n - i or i + same > prev.size()) return false;
+        std::copy(prev.begin() + i, prev.begin() + i + same, cur.begin() + i);
+        i += same;
+        if (pos >= enc.size()) return false;
+        size_t changed = get_varint(enc, pos);
+        if (changed > n - i or changed > enc.size() - pos) return false;
+        std::copy(enc.begin() + pos, enc.begin() + pos + changed, cur.begin() + i);
+        i += changed;
+        pos += changed;
+    }
+    return true;
+}
+
+}
+
+}
+
+#endif // FCPP_WIRE_FORMAT_H_
@@ -0,0 +1,31 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include <iostream>
+
+#include "lib/columnar_output.hpp"
+
+
+using namespace fcpp;
+
+
+/**
+ * @brief Prints the content of a columnar file as tab-separated values.
+ *
+ * Usage: `columnar_dump file [column...]`, printing the given columns (all of them by default).
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " file [column...]" << std::endl;
+        return 1;
+    }
+    columnar::reader data(argv[1]);
+    std::vector<size_t> cols;
+    for (int i = 2; i < argc; ++i) cols.push_back(data.column(argv[i]));
+    if (argc == 2) for (size_t c = 0; c < data.columns().size(); ++c) cols.push_back(c);
+    for (size_t c = 0; c < cols.size(); ++c)
+        std::cout << data.columns()[cols[c]] << (c + 1 < cols.size() ? "\t" : "\n");
+    for (size_t r = 0; r < data.rows(); ++r)
+        for (size_t c = 0; c < cols.size(); ++c)
+            std::cout << data(r, cols[c]) << (c + 1 < cols.size() ? "\t" : "\n");
+    return 0;
+}
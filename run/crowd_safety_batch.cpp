@@ -0,0 +1,40 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include "lib/crowd_safety.hpp"
+#include "lib/plot_downsample.hpp"
+
+
+using namespace fcpp;
+
+
+/**
+ * @brief Runs the case study headless.
+ *
+ * Arguments (all optional): number of threads, trace file to record (`-` for none), columnar file
+ * where to write aggregated data instead of the plots on standard output (`-` for none), file where
+ * to dump the provenance of monitor violations (`-` for none).
+ */
+int crowd_safety_batch(int argc, char** argv) {
+    if (argc > 2 and std::string(argv[2]) != "-")
+        proposition_trace::recorder::instance().open(argv[2], option::trace_props);
+    if (argc > 4 and std::string(argv[4]) != "-")
+        provenance::dumper::instance().open(argv[4]);
+    if (argc > 3 and std::string(argv[3]) != "-") {
+        columnar::writer w(argv[3]);
+        batch_runner::run<option::list<true, columnar::writer>>("Crowd Safety", w, batch_runner::threads(argc, argv));
+        return 0;
+    }
+    plot::bounded<option::plotter_t> p;
+    std::cout << "/*\n";
+    batch_runner::run<option::list<true, plot::bounded<option::plotter_t>>>("Crowd Safety", p, batch_runner::threads(argc, argv));
+    std::cout << "*/\n";
+    std::cout << plot::file("crowd_safety_batch", plot::downsampled(p.build()));
+    return 0;
+}
+
+#ifndef FCPP_MULTI_RUNNER
+//! @brief Runs the case study headless, as its own binary.
+int main(int argc, char** argv) {
+    return crowd_safety_batch(argc, argv);
+}
+#endif
@@ -0,0 +1,72 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+
+#include "lib/crowd_safety.hpp"
+
+
+using namespace fcpp;
+using namespace component::tags;
+using namespace coordination::tags;
+
+
+//! @brief Runs the case study in a large venue with a given number of people, printing a JSON result.
+template <bool parallel>
+void scale_run(size_t nodes, size_t threads, bool last) {
+    using net_t = typename component::batch_simulator<option::large_list<parallel>>::net;
+    // same density of people and areas as the demo (100 people and 5 areas in 500x500)
+    coordination::parameters& p = sweep::defaults<coordination::parameters>();
+    p = coordination::parameters{};
+    p.world_radius = coordination::world_radius * std::sqrt(nodes / 100.0);
+    p.nareas = coordination::nareas * nodes / 100;
+    double start_mb = batch_runner::peak_resident_mb();
+    auto start = std::chrono::steady_clock::now();
+    size_t rounds;
+    double mem_mb, build, wall;
+    std::stringstream by_call;
+    {
+        net_t network{common::make_tagged_tuple<component::tags::threads>(threads)};
+        std::mt19937_64 rnd(42);
+        std::uniform_real_distribution<real_t> pos(0, p.world_radius);
+        for (size_t i = 0; i < nodes; ++i)
+            network.node_emplace(common::make_tagged_tuple<x>(make_vec(pos(rnd), pos(rnd))));
+        build = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        size_t start_rounds = batch_runner::total_rounds();
+        start = std::chrono::steady_clock::now();
+        network.run();
+        wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        rounds = batch_runner::total_rounds() - start_rounds;
+        mem_mb = batch_runner::peak_resident_mb() - start_mb;
+        coordination::memory_report<distance_routine, local_safety_monitor, global_safety_monitor>(network, by_call);
+    }
+    std::cout << "  {\"nodes\": " << nodes << ", \"areas\": " << p.nareas << ", \"side\": " << p.world_radius;
+    std::cout << ", \"threads\": " << threads << ", \"build_s\": " << build << ", \"run_s\": " << wall;
+    std::cout << ", \"rounds_per_s\": " << rounds / double(nodes) / wall << ", \"node_rounds_per_s\": " << rounds / wall;
+    std::cout << ", \"memory_mb\": " << mem_mb << ", \"est_nbr_bytes_per_node\": " << by_call.str() << "}" << (last ? "\n" : ",\n");
+}
+
+/**
+ * @brief Benchmarks the case study in large venues, single-threaded and parallel, printing the results as JSON.
+ *
+ * Usage: `crowd_safety_scale [nodes,nodes...] [threads]` (by default, 10000, 50000 and 100000 people
+ * and the hardware concurrency). Every run is performed in a child process, whose growth in peak
+ * resident memory is reported.
+ */
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes;
+    std::stringstream ss(argc > 1 ? argv[1] : "10000,50000,100000");
+    for (std::string s; std::getline(ss, s, ',');) sizes.push_back(std::stoul(s));
+    size_t threads = batch_runner::threads(argc - 1, argv + 1);
+    std::cout << "[\n";
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        bool last = i + 1 == sizes.size();
+        batch_runner::isolated([&](){ scale_run<false>(sizes[i], 1, false); });
+        batch_runner::isolated([&](){ scale_run<true>(sizes[i], threads, last); });
+    }
+    std::cout << "]\n";
+    return 0;
+}
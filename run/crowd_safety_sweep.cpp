@@ -0,0 +1,23 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include "lib/crowd_safety.hpp"
+
+
+using namespace fcpp;
+
+
+/**
+ * @brief Runs a parameter sweep of the case study, printing a table of the average aggregated values.
+ *
+ * Usage: `crowd_safety_sweep threads seeds name=v1,v2... name=first:last:step...`.
+ */
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " threads seeds name=v1,v2... name=first:last:step..." << std::endl;
+        return 1;
+    }
+    std::vector<sweep::axis> axes;
+    for (int i = 3; i < argc; ++i) axes.push_back(sweep::parse_axis(argv[i]));
+    sweep::run<option::list<false, sweep::summary>, coordination::parameters>(axes, std::max(1, std::atoi(argv[2])), batch_runner::threads(argc, argv));
+    return 0;
+}
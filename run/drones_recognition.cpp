@@ -1,6 +1,7 @@
 // Copyright © 2021 Giorgio Audrito. All Rights Reserved.
 
 #include "lib/drones_recognition.hpp"
+#include "lib/plot_downsample.hpp"
 
 
 using namespace fcpp;
@@ -8,89 +9,14 @@ using namespace component::tags;
 using namespace coordination::tags;
 
 
-//! @brief Number of drones in the area.
-constexpr size_t drones_num = 50;
-
-//! @brief Dimensionality of the space.
-constexpr size_t dim = 3;
-
-//! @brief Final time for the plots.
-constexpr size_t end_time = 300;
-
-
-//! @brief Description of the round schedule.
-using round_s = sequence::periodic<
-    distribution::interval_n<times_t, 0, 1>,
-    distribution::weibull_n<times_t, 10, 1, 10>,
-    distribution::constant_n<times_t, 2*end_time>
->;
-
-//! @brief Description of the export schedule.
-using export_s = sequence::periodic_n<1, 0, 1, end_time>;
-
-//! @brief Description of the sequence of node creation events.
-using spawn_s = sequence::multiple_n<drones_num, 0>;
-
-//! @brief Description of the initial position distribution.
-using rectangle_d = distribution::rect_n<1, 0, 0, 0, 1000, 1000, 0>;
-
-//! @brief Storage tags and types.
-using storage_t = tuple_store<
-    fail<handling_monitor<1>>,      bool,
-    fail<redundancy_monitor<1>>,    bool,
-    fail<handling_monitor<2>>,      bool,
-    fail<redundancy_monitor<2>>,    bool,
-    fail<handling_monitor<3>>,      bool,
-    fail<redundancy_monitor<3>>,    bool,
-    fail<handling_monitor<4>>,      bool,
-    fail<redundancy_monitor<4>>,    bool,
-    col,                            color,
-    size,                           double
->;
-
-//! @brief Storage tags to be logged with aggregators.
-using aggregator_t = aggregators<
-    fail<handling_monitor<1>>,      aggregator::mean<double>,
-    fail<redundancy_monitor<1>>,    aggregator::mean<double>,
-    fail<handling_monitor<2>>,      aggregator::mean<double>,
-    fail<redundancy_monitor<2>>,    aggregator::mean<double>,
-    fail<handling_monitor<3>>,      aggregator::mean<double>,
-    fail<redundancy_monitor<3>>,    aggregator::mean<double>,
-    fail<handling_monitor<4>>,      aggregator::mean<double>,
-    fail<redundancy_monitor<4>>,    aggregator::mean<double>
->;
-
-//! @brief Plot description.
-using plotter_t = plot::plotter<aggregator_t, plot::time, fail>;
-
-//! @brief Options list.
-DECLARE_OPTIONS(opt,
-    parallel<false>,
-    synchronised<false>,
-    dimension<dim>,
-    program<coordination::main>,
-    exports<coordination::main_t>,
-    retain<metric::retain<2,1>>,
-    connector<connect::hierarchical<connect::powered<750, 1, dim>>>,
-    round_schedule<round_s>,
-    log_schedule<export_s>,
-    spawn_schedule<spawn_s>,
-    init<x, rectangle_d>,
-    storage_t,
-    aggregator_t,
-    plot_type<plotter_t>,
-    size_tag<size>,
-    color_tag<col>
-);
-
 int main() {
-    plotter_t p;
+    plot::bounded<option::plotter_t> p;
     std::cout << "/*\n";
     {
-        component::interactive_simulator<opt>::net network{common::make_tagged_tuple<plotter,name,texture>(&p,"Drones Recognition","land.jpg")};
+        component::interactive_simulator<option::list<false, plot::bounded<option::plotter_t>>>::net network{common::make_tagged_tuple<plotter,name,texture>(&p,"Drones Recognition","land.jpg")};
         network.run();
     }
     std::cout << "*/\n";
-    std::cout << plot::file("drones_recognition", p.build());
+    std::cout << plot::file("drones_recognition", plot::downsampled(p.build()));
     return 0;
 }
@@ -0,0 +1,102 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include "lib/logic_benchmark.hpp"
+
+
+using namespace fcpp;
+using namespace component::tags;
+using namespace coordination::tags;
+
+
+//! @brief Number of heap allocations performed so far.
+std::atomic<size_t> allocations{0};
+
+//! @brief Heap allocation, counting calls.
+void* operator new(size_t n) {
+    ++allocations;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+//! @brief Heap deallocation.
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+//! @brief Sized heap deallocation.
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+//! @brief The network type used in the benchmark.
+using net_t = component::batch_simulator<option::list<true>>::net;
+
+/**
+ * @brief Benchmarks every formula on a random network, printing the results as JSON.
+ *
+ * A last entry checks the constant-size `all_response_time` against its recursive definition on
+ * the same network, and the exit status is non-zero if they ever disagreed.
+ *
+ * Usage: `logic_benchmark [nodes] [degree] [density] [threads]`.
+ */
+int main(int argc, char** argv) {
+    size_t nodes   = argc > 1 ? std::atoi(argv[1]) : 1000;
+    real_t degree  = argc > 2 ? std::atof(argv[2]) : 10;
+    real_t density = argc > 3 ? std::atof(argv[3]) : 0.1;
+    size_t threads = batch_runner::threads(argc - 3, argv + 3);
+    // side of the square area giving the requested average degree with unit communication radius
+    real_t side = std::sqrt(nodes * M_PI / degree);
+    auto populate = [&](net_t& network, int f) {
+        std::mt19937_64 rnd(42);
+        std::uniform_real_distribution<real_t> pos(0, side);
+        for (size_t i = 0; i < nodes; ++i)
+            network.node_emplace(common::make_tagged_tuple<x, formula_id, coordination::tags::density>(make_vec(pos(rnd), pos(rnd)), f, density));
+    };
+    auto const& formulas = coordination::bench_formulas();
+    std::cout << "[\n";
+    for (size_t f = 0; f < formulas.size(); ++f) {
+        net_t network{common::make_tagged_tuple<component::tags::threads>(threads)};
+        populate(network, int(f));
+        size_t start_allocs = allocations;
+        size_t start_rounds = batch_runner::total_rounds();
+        auto start = std::chrono::steady_clock::now();
+        network.run();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        size_t allocs = allocations - start_allocs;
+        size_t rounds = batch_runner::total_rounds() - start_rounds;
+        // rounds after which the formula had its settled value, stopping quiescent operators
+        size_t false_rounds = 0;
+        for (device_t uid = 0, n = 0; n < network.node_size(); ++uid)
+            if (network.node_count(uid)) {
+                false_rounds += network.node_at(uid).storage(coordination::tags::false_rounds{});
+                ++n;
+            }
+        double settled = double(formulas[f].absorbing ? rounds - false_rounds : false_rounds) / rounds;
+        double bytes = (1 - settled) * formulas[f].est_export_bytes() + settled * formulas[f].est_settled_bytes();
+        std::cout << "  {\"formula\": \"" << formulas[f].name << "\", \"variant\": \"" << formulas[f].variant << "\"";
+        std::cout << ", \"nodes\": " << nodes << ", \"degree\": " << degree << ", \"density\": " << density << ", \"threads\": " << threads;
+        std::cout << ", \"node_rounds\": " << rounds << ", \"ns_per_node_round\": " << ns / rounds;
+        std::cout << ", \"allocs_per_round\": " << allocs * double(nodes) / rounds;
+        std::cout << ", \"settled_fraction\": " << settled << ", \"est_export_bytes\": " << bytes << "},\n";
+    }
+    net_t network{common::make_tagged_tuple<component::tags::threads>(threads)};
+    populate(network, coordination::equivalence_check);
+    size_t start_rounds = batch_runner::total_rounds();
+    network.run();
+    size_t mismatches = 0;
+    for (device_t uid = 0, n = 0; n < network.node_size(); ++uid)
+        if (network.node_count(uid)) {
+            mismatches += network.node_at(uid).storage(coordination::tags::mismatches{});
+            ++n;
+        }
+    std::cout << "  {\"check\": \"all_response_time == !EP(no_reply)\", \"nodes\": " << nodes;
+    std::cout << ", \"node_rounds\": " << batch_runner::total_rounds() - start_rounds << ", \"mismatches\": " << mismatches << "}\n";
+    std::cout << "]\n";
+    return mismatches == 0 ? 0 : 1;
+}
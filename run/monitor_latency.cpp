@@ -0,0 +1,57 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include "lib/detection_latency.hpp"
+
+
+using namespace fcpp;
+
+
+/**
+ * @brief Measures the detection latency and cost of distributed monitors on a recorded trace, printing a JSON summary.
+ *
+ * Usage: `monitor_latency scenario trace formula[:bit,bit...]...`, where the scenario is a label for
+ * the summary and the bits give the trace propositions used as propositions of the formula (defaulting
+ * to the first ones in order). Every formula is checked against its centralized reference.
+ */
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "usage: " << argv[0] << " scenario trace formula[:bit,bit...]..." << std::endl;
+        std::cerr << "available formulas:";
+        for (auto const& f : streaming::formulas()) std::cerr << " " << f.first;
+        std::cerr << std::endl;
+        return 1;
+    }
+    proposition_trace::reader trace(argv[2]);
+    std::vector<std::unique_ptr<proposition_trace::detection>> monitors;
+    for (int i = 3; i < argc; ++i) {
+        try {
+            monitors.emplace_back(new proposition_trace::detection(argv[i], trace.props()));
+        } catch (std::invalid_argument const& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    trace.for_each([&](proposition_trace::reader::record const& r){
+        for (auto& m : monitors) m->step(r);
+    });
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "{\"scenario\": \"" << argv[1] << "\", \"node_rounds\": " << (monitors.empty() ? 0 : monitors[0]->rounds()) << ", \"replay_s\": " << wall << ", \"monitors\": [\n";
+    for (size_t i = 0; i < monitors.size(); ++i) {
+        proposition_trace::detection const& m = *monitors[i];
+        std::cout << "  {\"formula\": \"" << argv[i + 3] << "\", \"episodes\": " << m.episodes() << ", \"detected\": " << m.detected();
+        std::cout << ", \"missed\": " << m.missed() << ", \"pending\": " << m.pending() << ", \"false_alarms\": " << m.false_alarms();
+        if (m.detected()) {
+            std::cout << ", \"latency_rounds\": {\"mean\": " << m.mean_rounds() << ", \"p50\": " << m.quantile_rounds(0.5) << ", \"p95\": " << m.quantile_rounds(0.95) << ", \"max\": " << m.quantile_rounds(1) << "}";
+            std::cout << ", \"latency_time\": {\"mean\": " << m.mean_time() << ", \"p50\": " << m.quantile_time(0.5) << ", \"p95\": " << m.quantile_time(0.95) << ", \"max\": " << m.quantile_time(1) << "}";
+        }
+        std::cout << ", \"bytes_per_round\": " << m.state_bytes() << ", \"bytes_received\": " << m.state_bytes() * m.messages();
+        std::cout << ", \"messages_per_round\": " << m.messages() / double(m.rounds()) << "}" << (i + 1 < monitors.size() ? ",\n" : "\n");
+    }
+    std::cout << "]}\n";
+    return 0;
+}
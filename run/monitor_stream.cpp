@@ -0,0 +1,85 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "lib/streaming_monitor.hpp"
+
+
+using namespace fcpp;
+
+
+//! @brief Opens the source of events: a file, `-` for standard input, or `unix:path` to accept a connection on a local socket.
+FILE* open_source(std::string const& source) {
+    if (source == "-") return stdin;
+    if (source.compare(0, 5, "unix:") != 0) return std::fopen(source.c_str(), "r");
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, source.c_str() + 5, sizeof(addr.sun_path) - 1);
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(addr.sun_path);
+    if (server < 0 or bind(server, (sockaddr*)&addr, sizeof(addr)) < 0 or listen(server, 1) < 0) return nullptr;
+    int client = accept(server, nullptr, nullptr);
+    close(server);
+    unlink(addr.sun_path);
+    return client < 0 ? nullptr : fdopen(client, "r");
+}
+
+/**
+ * @brief Evaluates formulas on a stream of events, printing the verdicts that changed.
+ *
+ * Usage: `monitor_stream source formula[:bit,bit...]...`, where the source is a file (or pipe),
+ * `-` for standard input, or `unix:path` for a local socket to listen on. Every line printed has the
+ * time, device, formula and new value of a verdict which changed in a round. Throughput and latency
+ * of batches are printed on standard error at the end of the stream.
+ */
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " source formula[:bit,bit...]..." << std::endl;
+        std::cerr << "available formulas:";
+        for (auto const& f : streaming::formulas()) std::cerr << " " << f.first;
+        std::cerr << std::endl;
+        return 1;
+    }
+    std::unique_ptr<streaming::network> net;
+    try {
+        net.reset(new streaming::network(std::vector<std::string>(argv + 2, argv + argc)));
+    } catch (std::invalid_argument const& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    FILE* in = open_source(argv[1]);
+    if (in == nullptr) {
+        std::cerr << "cannot open source " << argv[1] << std::endl;
+        return 1;
+    }
+    // last verdict of every monitor on every device
+    std::unordered_map<uint64_t, bool> last;
+    std::vector<streaming::event> batch;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        while (streaming::read_batch(in, batch)) {
+            for (streaming::verdict const& v : net->process(batch)) {
+                auto it = last.emplace(uint64_t(v.uid) << 32 | v.monitor, not v.value).first;
+                if (it->second == v.value) continue;
+                it->second = v.value;
+                std::printf("%g %u %s %d\n", v.time, v.uid, net->names()[v.monitor].c_str(), int(v.value));
+            }
+            std::fflush(stdout);
+        }
+    } catch (std::invalid_argument const& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << net->events() << " events in " << net->batches() << " batches, " << wall << " s (" << net->events() / wall << " events/s sustained, ";
+    std::cerr << net->events() / net->busy() << " events/s processing)\n";
+    std::cerr << "batch latency: p50 " << net->latency(0.5) * 1e6 << " us, p99 " << net->latency(0.99) * 1e6 << " us, max " << net->latency(1) * 1e6 << " us\n";
+    return 0;
+}
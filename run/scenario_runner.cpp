@@ -0,0 +1,40 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include <iostream>
+#include <map>
+#include <string>
+
+
+//! @brief Entry points of the headless case studies (compiled separately, with `FCPP_MULTI_RUNNER` defined).
+//! @{
+int crowd_safety_batch(int argc, char** argv);
+int drones_recognition_batch(int argc, char** argv);
+int service_discovery_batch(int argc, char** argv);
+int smart_grid_batch(int argc, char** argv);
+int smart_home_batch(int argc, char** argv);
+//! @}
+
+//! @brief The case studies, by name.
+std::map<std::string, int(*)(int, char**)> const scenarios = {
+    {"crowd_safety",        crowd_safety_batch},
+    {"drones_recognition",  drones_recognition_batch},
+    {"service_discovery",   service_discovery_batch},
+    {"smart_grid",          smart_grid_batch},
+    {"smart_home",          smart_home_batch}
+};
+
+/**
+ * @brief Runs a case study headless, selected by name.
+ *
+ * Usage: `scenario_runner scenario [arguments...]`, with the arguments of the corresponding batch target.
+ */
+int main(int argc, char** argv) {
+    if (argc < 2 or scenarios.count(argv[1]) == 0) {
+        std::cerr << "usage: " << argv[0] << " scenario [arguments of its batch target...]" << std::endl;
+        std::cerr << "available scenarios:";
+        for (auto const& s : scenarios) std::cerr << " " << s.first;
+        std::cerr << std::endl;
+        return 1;
+    }
+    return scenarios.at(argv[1])(argc - 1, argv + 1);
+}
@@ -0,0 +1,24 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include "lib/service_discovery.hpp"
+#include "lib/warm_fork.hpp"
+
+
+using namespace fcpp;
+
+
+/**
+ * @brief Runs what-if variants of the case study forked from a warm network, printing a table of the average aggregated values.
+ *
+ * Usage: `service_discovery_fork warmup jobs name=v1,v2... name=first:last:step...`.
+ */
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " warmup jobs name=v1,v2... name=first:last:step..." << std::endl;
+        return 1;
+    }
+    std::vector<sweep::axis> axes;
+    for (int i = 3; i < argc; ++i) axes.push_back(sweep::parse_axis(argv[i]));
+    sweep::warm_fork<option::list<false, sweep::summary>, coordination::parameters>(std::atof(argv[1]), axes, batch_runner::threads(argc - 1, argv + 1));
+    return 0;
+}
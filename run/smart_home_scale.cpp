@@ -0,0 +1,105 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+
+#include "lib/smart_home.hpp"
+
+
+using namespace fcpp;
+using namespace component::tags;
+using namespace coordination::tags;
+
+
+//! @brief Rooms on each side of the corridor of every floor.
+constexpr size_t columns = 25;
+
+//! @brief Runs the case study in a building with a given number of rooms and occupants, printing a JSON result.
+template <bool parallel>
+void scale_run(size_t rooms, size_t people, size_t threads, bool last) {
+    using net_t = typename component::batch_simulator<option::large_list<parallel>>::net;
+    coordination::parameters& p = sweep::defaults<coordination::parameters>();
+    p = coordination::parameters{};
+    p.columns = columns;
+    p.floors = std::max<size_t>(rooms / (2 * columns), 1);
+    coordination::building b{p};
+    double start_mb = batch_runner::peak_resident_mb();
+    auto start = std::chrono::steady_clock::now();
+    size_t rounds, nodes = b.lights() + people;
+    double mem_mb, build, wall;
+    std::stringstream by_call;
+    {
+        net_t network{common::make_tagged_tuple<component::tags::threads>(threads)};
+        for (size_t i = 0; i < b.lights(); ++i)
+            network.node_emplace(common::make_tagged_tuple<x>(b.light(i)));
+        // occupants spread evenly among floors
+        std::mt19937_64 rnd(42);
+        std::uniform_real_distribution<real_t> px(0, b.width()), py(0, b.depth());
+        for (size_t i = 0; i < people; ++i)
+            network.node_emplace(common::make_tagged_tuple<x>(make_vec(px(rnd), py(rnd), coordination::building::floor_gap * (i % b.floors()))));
+        build = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        size_t start_rounds = batch_runner::total_rounds();
+        start = std::chrono::steady_clock::now();
+        network.run();
+        wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        rounds = batch_runner::total_rounds() - start_rounds;
+        mem_mb = batch_runner::peak_resident_mb() - start_mb;
+        coordination::memory_report<local_strong_monitor, local_weak_monitor, global_strong_monitor, global_weak_monitor>(network, by_call);
+    }
+    std::cout << "  {\"rooms\": " << b.rooms() << ", \"floors\": " << b.floors() << ", \"lights\": " << b.lights() << ", \"people\": " << people;
+    std::cout << ", \"threads\": " << threads << ", \"build_s\": " << build << ", \"run_s\": " << wall;
+    std::cout << ", \"rounds_per_s\": " << rounds / double(nodes) / wall << ", \"node_rounds_per_s\": " << rounds / wall;
+    std::cout << ", \"memory_mb\": " << mem_mb << ", \"est_nbr_bytes_per_node\": " << by_call.str() << "}" << (last ? "\n" : ",\n");
+}
+
+/**
+ * @brief Checks that no light detects presence in an empty building.
+ *
+ * Rooms have several lights, which are in range of each other, so that lights counted as people
+ * would make every light detect presence.
+ */
+bool empty_building_check() {
+    using net_t = typename component::batch_simulator<option::large_list<false>>::net;
+    coordination::parameters& p = sweep::defaults<coordination::parameters>();
+    p = coordination::parameters{};
+    p.room_lights = 3;
+    coordination::building b{p};
+    net_t network{common::make_tagged_tuple<component::tags::threads>(1)};
+    for (size_t i = 0; i < b.lights(); ++i)
+        network.node_emplace(common::make_tagged_tuple<x>(b.light(i)));
+    network.run();
+    for (device_t uid = 0; uid < b.lights(); ++uid)
+        if (network.node_at(uid).storage(occupants{}) != 0) return false;
+    return true;
+}
+
+/**
+ * @brief Benchmarks the case study in generated buildings, single-threaded and parallel, printing the results as JSON.
+ *
+ * Usage: `smart_home_scale [rooms,rooms...] [people per room] [threads]` (by default, 100, 1000 and
+ * 5000 rooms, 5 people per room and the hardware concurrency). Buildings have 25 rooms on each side
+ * of the corridor of every floor. Lights are first checked not to detect presence in an empty building.
+ * Every run is performed in a child process, whose growth in peak resident memory is reported.
+ */
+int main(int argc, char** argv) {
+    if (not empty_building_check()) {
+        std::cerr << "lights detect presence in an empty building" << std::endl;
+        return 1;
+    }
+    std::vector<size_t> sizes;
+    std::stringstream ss(argc > 1 ? argv[1] : "100,1000,5000");
+    for (std::string s; std::getline(ss, s, ',');) sizes.push_back(std::stoul(s));
+    double density = argc > 2 ? std::atof(argv[2]) : 5;
+    size_t threads = batch_runner::threads(argc - 2, argv + 2);
+    std::cout << "[\n";
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        size_t people = sizes[i] * density;
+        bool last = i + 1 == sizes.size();
+        batch_runner::isolated([&](){ scale_run<false>(sizes[i], people, 1, false); });
+        batch_runner::isolated([&](){ scale_run<true>(sizes[i], people, threads, last); });
+    }
+    std::cout << "]\n";
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Copyright © 2026 Giorgio Audrito. All Rights Reserved.
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include "lib/streaming_monitor.hpp"
+
+
+using namespace fcpp;
+using namespace coordination;
+
+
+/**
+ * @brief Evaluates formulas on a recorded trace, without simulating the network.
+ *
+ * Usage: `trace_replay trace formula[:bit,bit...]...`, where the bits give the trace propositions
+ * used as propositions of the formula (defaulting to the first ones in order).
+ */
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " trace formula[:bit,bit...]..." << std::endl;
+        std::cerr << "available formulas:";
+        for (auto const& f : streaming::formulas()) std::cerr << " " << f.first;
+        std::cerr << std::endl;
+        return 1;
+    }
+    proposition_trace::reader trace(argv[1]);
+    std::vector<std::string> names;
+    std::vector<std::unique_ptr<proposition_trace::replay_base>> monitors;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        try {
+            monitors.push_back(streaming::make_monitor(arg, trace.props()));
+        } catch (std::invalid_argument const& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        names.push_back(arg);
+    }
+    size_t rounds = 0;
+    std::vector<size_t> falsities(monitors.size(), 0);
+    std::vector<double> first_false(monitors.size(), -1);
+    auto start = std::chrono::steady_clock::now();
+    trace.for_each([&](proposition_trace::reader::record const& r){
+        ++rounds;
+        for (size_t i = 0; i < monitors.size(); ++i)
+            if (not monitors[i]->step(r)) {
+                if (falsities[i]++ == 0) first_false[i] = r.time;
+            }
+    });
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (size_t i = 0; i < monitors.size(); ++i) {
+        std::cout << names[i] << ": false in " << falsities[i] << " of " << rounds << " node-rounds";
+        if (falsities[i]) std::cout << " (first at time " << first_false[i] << ")";
+        std::cout << "\n";
+    }
+    std::cout << "replayed " << rounds << " node-rounds in " << wall << " s (" << rounds / wall << " node-rounds/s)\n";
+    return 0;
+}